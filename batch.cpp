@@ -0,0 +1,652 @@
+// Ordonnanceur en ligne de commande, sans GTK.
+// Compilation : g++ -O2 -std=c++17 -pthread batch.cpp -o batch
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cache.h"
+#include "engine.h"
+#include "export.h"
+#include "metrics.h"
+#include "online.h"
+#include "options.h"
+#include "policies.h"
+#include "profile.h"
+#include "process_table.h"
+#include "results.h"
+#include "smp.h"
+#include "sweep.h"
+#include "trace.h"
+#include "workload.h"
+
+static void usage(const char *program)
+{
+    std::cerr << "Usage : " << program << " [options] <charge.csv | trace.bin | ->\n"
+              << "  -p, --policy <nom>                   politique (défaut : fcfs) : " << policyNames() << "\n"
+              << "  -q, --quantum <n>                    quantum du tourniquet, du premier niveau de mlfq\n"
+              << "      --levels <n>                     mlfq : nombre de niveaux (défaut : 3)\n"
+              << "      --boost <n>                      mlfq : période de remontée au niveau 0\n"
+              << "      --latency <n>                    cfs : période partagée entre les prêts (défaut : 24)\n"
+              << "      --granularity <n>                cfs : tranche minimale (défaut : 3)\n"
+              << "  -o, --output <fichier>               écrire les résultats dans un fichier\n"
+              << "  -s, --summary                        n'afficher que les moyennes\n"
+              << "  -m, --metrics                        ajouter centiles, débit, utilisation et\n"
+              << "                                       changements de contexte\n"
+              << "  -l, --live                           ordonnancer en ligne, en mémoire bornée :\n"
+              << "                                       résultats écrits à chaque terminaison\n"
+              << "  -S, --sort                           charger et trier une trace non triée\n"
+              << "  -c, --convert <trace.bin>            convertir la charge en trace binaire\n"
+              << "  -w, --sweep                          balayer les politiques et quantums donnés\n"
+              << "                                       en listes (ex : -p rr,sjf -q 1,2,4,8)\n"
+              << "  -j, --jobs <n>                       nombre de fils du balayage\n"
+              << "  -P, --cpus <n>                       simuler n processeurs (files par processeur)\n"
+              << "      --switch-cost <n>                coût d'un changement de contexte\n"
+              << "      --migration-cost <n>             coût d'une migration entre processeurs\n"
+              << "      --export-results <fichier>       exporter les résultats par processus, au fil\n"
+              << "                                       des terminaisons (.csv, .jsonl ou .ordc)\n"
+              << "      --export-timeline <fichier>      exporter la chronologie (.csv, .jsonl ou .ordc) ;\n"
+              << "                                       avec -l, rien n'est gardé en mémoire\n"
+              << "      --cache                          réutiliser les résultats d'une simulation\n"
+              << "                                       identique (même charge, mêmes paramètres)\n"
+              << "      --cache-dir <répertoire>         cache à utiliser (défaut : " << ResultCache::defaultDirectory() << ")\n"
+              << "      --profile <trace.json>           compteurs et temps par section sur la sortie\n"
+              << "                                       d'erreur, trace Chrome dans le fichier (binaire\n"
+              << "                                       compilé avec -DORDONNANCEUR_PROFILE=1)\n";
+}
+
+static int runSweepMode(ProcessTable &processes, const std::string &policies,
+                        const std::string &quantums, const PolicyOptions &options, unsigned jobs,
+                        std::ostream &out)
+{
+    std::vector<std::string> policyNames = splitList(policies);
+    for (const auto &name : policyNames)
+    {
+        if (!makePolicy(name, 0))
+        {
+            std::cerr << "Politique inconnue : " << name << "\n";
+            return 2;
+        }
+    }
+    std::vector<int> quantumValues;
+    for (const auto &value : splitList(quantums))
+    {
+        quantumValues.push_back(atoi(value.c_str()));
+    }
+    if (quantumValues.empty())
+    {
+        quantumValues.push_back(0);
+    }
+
+    std::vector<SweepResult> results = runSweep(processes, sweepGrid(policyNames, quantumValues), jobs, options);
+
+    out << "Policy\tQuantum\tAvg waiting\tAvg turnaround\tAvg response"
+        << "\tP99 waiting\tP99 turnaround\tUtilization\tSwitches\n";
+    for (const auto &result : results)
+    {
+        out << result.config.policy << "\t";
+        if (findPolicy(result.config.policy)->usesQuantum)
+            out << result.config.quantum;
+        else
+            out << "-";
+        out << "\t" << result.averages.waiting << "\t" << result.averages.turnaround
+            << "\t" << result.averages.response << "\t" << result.metrics.waiting.percentile(0.99)
+            << "\t" << result.metrics.turnaround.percentile(0.99) << "\t" << result.metrics.utilization()
+            << "\t" << result.metrics.contextSwitches << "\n";
+    }
+    return 0;
+}
+
+// Fichiers d'export, alimentés au fil de la simulation
+class Exports
+{
+private:
+    std::string resultsPath;
+    std::string timelinePath;
+    std::unique_ptr<RowWriter> results;
+    std::unique_ptr<RowWriter> timeline;
+    std::unique_ptr<ScheduleExporter> exporter;
+
+    static bool open(const std::string &path, const char *const *columns, size_t count,
+                     std::unique_ptr<RowWriter> &writer)
+    {
+        if (path.empty())
+            return true;
+        writer = openRowWriter(path, columns, count);
+        if (!writer)
+        {
+            std::cerr << path << " : extension inconnue (.csv, .jsonl ou .ordc)\n";
+            return false;
+        }
+        if (!writer->isOpen())
+        {
+            std::cerr << "Impossible d'écrire " << path << "\n";
+            return false;
+        }
+        return true;
+    }
+
+    static bool close(const std::string &path, std::unique_ptr<RowWriter> &writer)
+    {
+        if (writer && !writer->close())
+        {
+            std::cerr << "Erreur d'écriture de " << path << "\n";
+            return false;
+        }
+        return true;
+    }
+
+public:
+    Exports(const std::string &resultsFile, const std::string &timelineFile)
+        : resultsPath(resultsFile), timelinePath(timelineFile) {}
+
+    bool requested() const
+    {
+        return !resultsPath.empty() || !timelinePath.empty();
+    }
+
+    bool open()
+    {
+        if (!open(resultsPath, processColumns, processColumnCount, results) ||
+            !open(timelinePath, segmentColumns, segmentColumnCount, timeline))
+            return false;
+        exporter = std::make_unique<ScheduleExporter>(results.get(), timeline.get());
+        return true;
+    }
+
+    // nullptr si aucun export n'est demandé
+    ScheduleSink *sink()
+    {
+        return requested() ? exporter.get() : nullptr;
+    }
+
+    // Exporte d'un bloc les résultats d'une simulation déjà faite
+    void write(const ProcessTable &processes, const Timeline &segments)
+    {
+        if (results)
+            exportResults(*results, processes);
+        if (timeline)
+            exportTimeline(*timeline, segments);
+    }
+
+    bool close()
+    {
+        if (exporter)
+            exporter->finish();
+        bool ok = close(resultsPath, results);
+        return close(timelinePath, timeline) && ok;
+    }
+};
+
+// Mode en ligne : la charge est soumise au fil de la lecture et chaque
+// processus est écrit dès sa fin, puis oublié
+static int runLiveMode(WorkloadSource &source, std::unique_ptr<SchedulingPolicy> policy,
+                       bool summaryOnly, Exports &exports, std::ostream &out)
+{
+    Metrics metrics;
+    OnlineScheduler scheduler(std::move(policy), &metrics);
+    scheduler.setSink(exports.sink());
+    std::vector<Completion> completed;
+    auto flush = [&]()
+    {
+        scheduler.pollCompletions(completed);
+        if (summaryOnly)
+            return;
+        for (const Completion &c : completed)
+        {
+            out << c.pid << "\tProcessus " << c.pid << "\t\t" << c.arrivalTime << "\t\t"
+                << c.burstTime << "\t\t" << c.priority << "\t\t" << c.waitingTime << "\t\t"
+                << c.turnaroundTime << "\t\t" << c.responseTime << "\n";
+        }
+    };
+
+    if (!summaryOnly)
+    {
+        out << "PID\tName\t\tArrival\t\tBurst\t\tPriority\t\tWaiting\t\tTurnaround\tResponse\n";
+    }
+    source.requireSortedArrivals();
+    TraceRecord record;
+    int pid = 0;
+    while (source.next(record))
+    {
+        if (!source.ioBursts().empty())
+        {
+            std::cerr << "--live : les entrées-sorties ne sont simulées qu'en simulation complète\n";
+            exports.close(); // fichiers lisibles jusqu'à la ligne refusée
+            return 2;
+        }
+        scheduler.advanceTo(record.arrivalTime);
+        if (!scheduler.submit(++pid, record))
+        {
+            std::cerr << "--live : processus " << pid << " refusé, arrivée " << record.arrivalTime
+                      << " antérieure à la date courante " << scheduler.now() << "\n";
+            exports.close();
+            return 1;
+        }
+        flush();
+    }
+    scheduler.finish();
+    flush();
+    if (!exports.close())
+        return 1;
+
+    if (!source.error().empty())
+    {
+        std::cerr << source.error() << "\n";
+        return 1;
+    }
+    if (!summaryOnly)
+    {
+        out << "\n";
+    }
+    writeMetrics(out, metrics);
+    return 0;
+}
+
+// Mode multiprocesseur : une file par processeur, puis le bilan par processeur
+static int runSmpMode(ProcessTable &processes, const SmpConfig &config, const std::string &policyName,
+                      const PolicyOptions &options, bool summaryOnly, bool withMetrics, std::ostream &out)
+{
+    std::vector<Timeline> timelines;
+    Metrics metrics;
+    SmpSimulator simulator(processes, config, [&]()
+                           { return makePolicy(policyName, options); },
+                           summaryOnly ? nullptr : &timelines);
+    simulator.setMetrics(&metrics);
+    simulator.run();
+
+    if (!summaryOnly)
+    {
+        writeProcessResults(out, processes);
+        out << "\nCPU\tPID\tStart\tEnd\n";
+        for (size_t c = 0; c < timelines.size(); ++c)
+        {
+            for (size_t i = 0; i < timelines[c].size(); ++i)
+            {
+                const Segment &segment = timelines[c][i];
+                out << c << "\t" << segment.pid << "\t" << segment.start << "\t" << segment.end << "\n";
+            }
+        }
+        out << "\n";
+    }
+    writeAverages(out, processes);
+    out << "\n";
+    writeSmpStats(out, simulator);
+    if (withMetrics)
+    {
+        out << "\n";
+        writeMetrics(out, metrics);
+    }
+    return 0;
+}
+
+// Bilan de l'instrumentation du fil principal, écrit à la sortie de main()
+class ProfileReport
+{
+private:
+    std::string tracePath;
+
+public:
+    explicit ProfileReport(const std::string &path) : tracePath(path) {}
+
+    ~ProfileReport()
+    {
+        if (tracePath.empty())
+            return;
+        std::cerr << "\n";
+        writeProfile(std::cerr, threadProfile());
+        std::ofstream trace(tracePath);
+        writeChromeTrace(trace, threadProfile());
+        if (!trace)
+            std::cerr << "Impossible d'écrire " << tracePath << "\n";
+    }
+};
+
+static bool convertTrace(WorkloadSource &source, const std::string &path, bool sortFirst)
+{
+    TraceWriter writer(path);
+    if (!writer.isOpen())
+    {
+        std::cerr << "Impossible d'écrire " << path << "\n";
+        return false;
+    }
+
+    bool written = true;
+    if (sortFirst)
+    {
+        ProcessTable processes;
+        loadWorkload(source, processes);
+        if (processes.hasIo())
+        {
+            std::cerr << "--convert : une trace binaire ne porte pas d'entrées-sorties\n";
+            return false;
+        }
+        processes.sortByArrival();
+        for (size_t i = 0; i < processes.size() && written; ++i)
+        {
+            written = writer.write({processes.arrivalTime[i], processes.burstTime[i], processes.priority[i]});
+        }
+    }
+    else
+    {
+        TraceRecord record;
+        source.requireSortedArrivals();
+        while (written && source.next(record))
+        {
+            if (!source.ioBursts().empty())
+            {
+                std::cerr << "--convert : une trace binaire ne porte pas d'entrées-sorties\n";
+                return false;
+            }
+            written = writer.write(record);
+        }
+    }
+
+    if (!source.error().empty())
+    {
+        std::cerr << source.error() << "\n";
+        return false;
+    }
+    if (!writer.close() || !written)
+    {
+        std::cerr << "Erreur d'écriture de " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    std::string policyName = "fcfs";
+    std::string inputPath;
+    std::string outputPath;
+    std::string convertPath;
+    std::string quantumText;
+    PolicyOptions options;
+    unsigned jobs = std::thread::hardware_concurrency();
+    bool summaryOnly = false;
+    bool withMetrics = false;
+    bool sortFirst = false;
+    bool sweep = false;
+    bool live = false;
+    bool useCache = false;
+    std::string cacheDirectory = ResultCache::defaultDirectory();
+    std::string profilePath;
+    std::string resultsExportPath;
+    std::string timelineExportPath;
+    SmpConfig smp;
+    smp.cpus = 1;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if ((arg == "-p" || arg == "--policy") && i + 1 < argc)
+        {
+            policyName = argv[++i];
+        }
+        else if ((arg == "-q" || arg == "--quantum") && i + 1 < argc)
+        {
+            quantumText = argv[++i];
+        }
+        else if (arg == "--levels" && i + 1 < argc)
+        {
+            options.levels = std::max(1, atoi(argv[++i]));
+        }
+        else if (arg == "--boost" && i + 1 < argc)
+        {
+            options.boostInterval = std::max(0, atoi(argv[++i]));
+        }
+        else if (arg == "--latency" && i + 1 < argc)
+        {
+            options.targetLatency = std::max(1, atoi(argv[++i]));
+        }
+        else if (arg == "--granularity" && i + 1 < argc)
+        {
+            options.minGranularity = std::max(1, atoi(argv[++i]));
+        }
+        else if ((arg == "-o" || arg == "--output") && i + 1 < argc)
+        {
+            outputPath = argv[++i];
+        }
+        else if ((arg == "-c" || arg == "--convert") && i + 1 < argc)
+        {
+            convertPath = argv[++i];
+        }
+        else if (arg == "-s" || arg == "--summary")
+        {
+            summaryOnly = true;
+        }
+        else if (arg == "-m" || arg == "--metrics")
+        {
+            withMetrics = true;
+        }
+        else if (arg == "-l" || arg == "--live")
+        {
+            live = true;
+        }
+        else if (arg == "-S" || arg == "--sort")
+        {
+            sortFirst = true;
+        }
+        else if (arg == "-w" || arg == "--sweep")
+        {
+            sweep = true;
+        }
+        else if ((arg == "-j" || arg == "--jobs") && i + 1 < argc)
+        {
+            jobs = std::max(1, atoi(argv[++i]));
+        }
+        else if ((arg == "-P" || arg == "--cpus") && i + 1 < argc)
+        {
+            smp.cpus = std::max(1, atoi(argv[++i]));
+        }
+        else if (arg == "--switch-cost" && i + 1 < argc)
+        {
+            smp.contextSwitchCost = std::max(0, atoi(argv[++i]));
+        }
+        else if (arg == "--migration-cost" && i + 1 < argc)
+        {
+            smp.migrationCost = std::max(0, atoi(argv[++i]));
+        }
+        else if (arg == "--cache")
+        {
+            useCache = true;
+        }
+        else if (arg == "--cache-dir" && i + 1 < argc)
+        {
+            useCache = true;
+            cacheDirectory = argv[++i];
+        }
+        else if (arg == "--profile" && i + 1 < argc)
+        {
+            profilePath = argv[++i];
+        }
+        else if (arg == "--export-results" && i + 1 < argc)
+        {
+            resultsExportPath = argv[++i];
+        }
+        else if (arg == "--export-timeline" && i + 1 < argc)
+        {
+            timelineExportPath = argv[++i];
+        }
+        else if (arg == "-h" || arg == "--help")
+        {
+            usage(argv[0]);
+            return 0;
+        }
+        else if (inputPath.empty() && (arg == "-" || arg[0] != '-'))
+        {
+            inputPath = arg;
+        }
+        else
+        {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (inputPath.empty())
+    {
+        usage(argv[0]);
+        return 2;
+    }
+
+    if (!profilePath.empty() && !ORDONNANCEUR_PROFILE)
+    {
+        std::cerr << "--profile : recompiler avec -DORDONNANCEUR_PROFILE=1\n";
+        return 2;
+    }
+    ProfileReport profileReport(profilePath);
+
+    std::unique_ptr<WorkloadSource> source = openWorkload(inputPath);
+    if (!convertPath.empty())
+    {
+        return convertTrace(*source, convertPath, sortFirst) ? 0 : 1;
+    }
+
+    std::ofstream file;
+    if (!outputPath.empty())
+    {
+        file.open(outputPath);
+        if (!file)
+        {
+            std::cerr << "Impossible d'écrire " << outputPath << "\n";
+            return 1;
+        }
+    }
+    std::ostream &out = outputPath.empty() ? std::cout : file;
+
+    bool multiprocessor = smp.cpus > 1 || smp.contextSwitchCost > 0 || smp.migrationCost > 0;
+    Exports exports(resultsExportPath, timelineExportPath);
+    if (exports.requested() && (sweep || multiprocessor))
+    {
+        std::cerr << "--export-results et --export-timeline : simulation sur un seul processeur\n";
+        return 2;
+    }
+    if (useCache && (sweep || multiprocessor || live))
+    {
+        std::cerr << "--cache : simulation complète sur un seul processeur\n";
+        return 2;
+    }
+    if (!exports.open())
+    {
+        return 1;
+    }
+
+    ProcessTable processes;
+    if (sweep)
+    {
+        if (!loadWorkload(*source, processes))
+        {
+            std::cerr << inputPath << " : " << source->error() << "\n";
+            return 1;
+        }
+        return runSweepMode(processes, policyName, quantumText, options, jobs, out);
+    }
+
+    options.quantum = atoi(quantumText.c_str());
+    std::unique_ptr<SchedulingPolicy> policy = makePolicy(policyName, options);
+    if (!policy)
+    {
+        std::cerr << "Politique inconnue : " << policyName << "\n";
+        return 2;
+    }
+
+    if (multiprocessor)
+    {
+        if (!loadWorkload(*source, processes))
+        {
+            std::cerr << inputPath << " : " << source->error() << "\n";
+            return 1;
+        }
+        if (processes.hasIo())
+        {
+            std::cerr << "--cpus : les entrées-sorties ne sont simulées que sur un seul processeur\n";
+            return 2;
+        }
+        return runSmpMode(processes, smp, policyName, options, summaryOnly, withMetrics, out);
+    }
+
+    if (live)
+    {
+        return runLiveMode(*source, std::move(policy), summaryOnly, exports, out);
+    }
+
+    Timeline timeline;
+    Metrics metrics;
+    ResultCache cache(cacheDirectory);
+    uint64_t cacheKey = 0;
+    bool cached = false;
+    if (useCache)
+    {
+        // La clé porte sur toute la charge : elle est chargée et triée d'abord
+        if (!loadWorkload(*source, processes))
+        {
+            std::cerr << inputPath << " : " << source->error() << "\n";
+            return 1;
+        }
+        processes.sortByArrival();
+        cacheKey = ResultCache::key(processes, policyName, options);
+        cached = cache.load(cacheKey, processes, timeline, metrics);
+    }
+
+    if (cached)
+    {
+        exports.write(processes, timeline);
+    }
+    else
+    {
+        std::unique_ptr<SimulationEngine> engine = makeEngine(policyName, processes, options,
+                                                              summaryOnly && !useCache ? nullptr : &timeline);
+        engine->setMetrics(&metrics);
+        engine->setSink(exports.sink());
+        bool loaded;
+        if (useCache)
+        {
+            engine->run();
+            loaded = true;
+        }
+        else if (sortFirst)
+        {
+            loaded = loadWorkload(*source, processes);
+            if (loaded)
+            {
+                engine->run();
+            }
+        }
+        else
+        {
+            loaded = engine->run(*source);
+        }
+        if (!loaded)
+        {
+            std::cerr << inputPath << " : " << source->error() << "\n";
+            return 1;
+        }
+        if (useCache && !cache.store(cacheKey, processes, timeline, metrics))
+        {
+            std::cerr << "Impossible d'écrire dans le cache " << cacheDirectory << "\n";
+        }
+    }
+    if (!exports.close())
+    {
+        return 1;
+    }
+
+    if (!summaryOnly)
+    {
+        writeResults(out, processes, timeline);
+        out << "\n";
+    }
+    writeAverages(out, processes);
+    if (withMetrics)
+    {
+        out << "\n";
+        writeMetrics(out, metrics);
+    }
+    return 0;
+}
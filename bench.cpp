@@ -0,0 +1,197 @@
+// Banc d'essai des politiques d'ordonnancement sur des charges synthétiques.
+// Compilation : g++ -O2 -std=c++17 -pthread bench.cpp -o bench
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include "engine.h"
+#include "generator.h"
+#include "options.h"
+#include "policies.h"
+#include "process_table.h"
+
+// Compteur global d'allocations, incrémenté par tous les operator new
+static std::atomic<size_t> allocationCount{0};
+
+void *operator new(size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void *memory = std::malloc(size ? size : 1))
+        return memory;
+    throw std::bad_alloc();
+}
+
+void *operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void *memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+// Remet à zéro le pic de mémoire résidente (Linux ≥ 4.0) ; sans effet ailleurs,
+// le pic reporté est alors celui du processus depuis son démarrage
+static void resetPeakRss()
+{
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    if (clearRefs)
+        clearRefs << "5";
+}
+
+static long peakRssKiB()
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+        if (line.compare(0, 6, "VmHWM:") == 0)
+            return atol(line.c_str() + 6);
+    }
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+static void usage(const char *program)
+{
+    std::cerr << "Usage : " << program << " [options]\n"
+              << "  -p, --policy <liste>   politiques mesurées (défaut : fcfs,rr,sjf,priority)\n"
+              << "  -q, --quantum <n>      quantum du tourniquet (défaut : 4)\n"
+              << "  -d, --dispatch <liste> boucles mesurées : virtual (appels virtuels),\n"
+              << "                         static (spécialisée par politique) (défaut : les deux)\n"
+              << "  -n, --max <n>          taille maximale, de 10 en 10 à partir de 10 (défaut : 1000000)\n"
+              << "  -b, --burst <exp|pareto>  loi des durées (défaut : exp)\n"
+              << "  -i, --io <n>           entrées-sorties sur n périphériques (défaut : aucune)\n"
+              << "  -s, --seed <n>         graine du générateur (défaut : 1)\n"
+              << "  -t, --min-time <ms>    durée minimale de mesure par cas (défaut : 200)\n";
+}
+
+int main(int argc, char **argv)
+{
+    std::string policies = "fcfs,rr,sjf,priority";
+    std::string dispatch = "virtual,static";
+    int quantum = 4;
+    size_t maxSize = 1000000;
+    double minTime = 0.2;
+    WorkloadSpec spec;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if ((arg == "-p" || arg == "--policy") && i + 1 < argc)
+            policies = argv[++i];
+        else if ((arg == "-q" || arg == "--quantum") && i + 1 < argc)
+            quantum = atoi(argv[++i]);
+        else if ((arg == "-d" || arg == "--dispatch") && i + 1 < argc)
+            dispatch = argv[++i];
+        else if ((arg == "-n" || arg == "--max") && i + 1 < argc)
+            maxSize = strtoull(argv[++i], nullptr, 10);
+        else if ((arg == "-b" || arg == "--burst") && i + 1 < argc)
+            spec.burstDistribution = std::string(argv[++i]) == "pareto" ? WorkloadSpec::Pareto : WorkloadSpec::Exponential;
+        else if ((arg == "-i" || arg == "--io") && i + 1 < argc)
+            spec.ioDevices = std::max(0, atoi(argv[++i]));
+        else if ((arg == "-s" || arg == "--seed") && i + 1 < argc)
+            spec.seed = strtoull(argv[++i], nullptr, 10);
+        else if ((arg == "-t" || arg == "--min-time") && i + 1 < argc)
+            minTime = atof(argv[++i]) / 1000;
+        else
+        {
+            usage(argv[0]);
+            return arg == "-h" || arg == "--help" ? 0 : 2;
+        }
+    }
+
+    std::vector<std::string> names = splitList(policies);
+    for (const auto &name : names)
+    {
+        if (!makePolicy(name, quantum))
+        {
+            std::cerr << "Politique inconnue : " << name << "\n";
+            return 2;
+        }
+    }
+    std::vector<std::string> modes = splitList(dispatch);
+    for (const auto &mode : modes)
+    {
+        if (mode != "virtual" && mode != "static")
+        {
+            std::cerr << "Boucle inconnue : " << mode << "\n";
+            return 2;
+        }
+    }
+
+    PolicyOptions options;
+    options.quantum = quantum;
+
+    std::printf("%-10s %-8s %10s %8s %12s %14s %12s\n",
+                "Policy", "Dispatch", "Processes", "Runs", "ns/process", "allocs/run", "peak KiB");
+
+    for (size_t size = 10; size <= maxSize; size *= 10)
+    {
+        spec.count = size;
+        ProcessTable workload;
+        generateWorkload(spec, workload);
+
+        for (const auto &name : names)
+        {
+            for (const auto &mode : modes)
+            {
+                using Clock = std::chrono::steady_clock;
+                ProcessTable processes = workload;
+                std::unique_ptr<SimulationEngine> engine = mode == "static"
+                                                               ? makeEngine(name, processes, options)
+                                                               : makeVirtualEngine(name, processes, options);
+
+                // Première simulation hors mesure : les allocations comptées
+                // sont celles du régime établi, tampons déjà dimensionnés
+                engine->run();
+
+                resetPeakRss();
+                size_t allocationsBefore = allocationCount.load();
+                size_t runs = 0;
+                double elapsed = 0;
+                do
+                {
+                    Clock::time_point start = Clock::now();
+                    engine->run();
+                    elapsed += std::chrono::duration<double>(Clock::now() - start).count();
+                    runs++;
+                } while (elapsed < minTime);
+                size_t allocations = allocationCount.load() - allocationsBefore;
+
+                std::printf("%-10s %-8s %10zu %8zu %12.1f %14.1f %12ld\n",
+                            name.c_str(), mode.c_str(), size, runs, elapsed * 1e9 / runs / size,
+                            static_cast<double>(allocations) / runs, peakRssKiB());
+                std::fflush(stdout);
+            }
+        }
+    }
+    return 0;
+}
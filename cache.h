@@ -0,0 +1,290 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "export.h"
+#include "metrics.h"
+#include "policies.h"
+#include "process_table.h"
+#include "timeline.h"
+
+// À incrémenter quand le moteur ou les politiques changent de résultats, ou
+// quand le contenu des entrées change : les entrées existantes cessent alors
+// d'être trouvées
+constexpr uint32_t resultCacheVersion = 2;
+
+// Empreinte 64 bits d'une suite de mots, mélangée à la manière de splitmix64
+class Fingerprint
+{
+private:
+    uint64_t state = 0x9e3779b97f4a7c15ull;
+
+    static uint64_t mix(uint64_t x)
+    {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ull;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebull;
+        return x ^ (x >> 31);
+    }
+
+public:
+    void add(uint64_t word)
+    {
+        state = mix(state ^ word) + 0x9e3779b97f4a7c15ull;
+    }
+
+    void add(const std::string &text)
+    {
+        add(text.size());
+        for (unsigned char c : text)
+            add(c);
+    }
+
+    // Deux int32 par mot : la charge est lue à la vitesse de la mémoire
+    void add(const std::vector<int> &column)
+    {
+        add(column.size());
+        size_t i = 0;
+        for (; i + 1 < column.size(); i += 2)
+            add(uint64_t(uint32_t(column[i])) << 32 | uint32_t(column[i + 1]));
+        if (i < column.size())
+            add(uint32_t(column[i]));
+    }
+
+    uint64_t value() const
+    {
+        return mix(state);
+    }
+};
+
+// Cache sur disque des résultats de simulation, adressé par leur contenu :
+// la clé est l'empreinte de la charge (triée par arrivée), de la politique et
+// de ses paramètres. Une entrée est faite de trois fichiers en colonnes
+// (export.h), lus par projection en mémoire : les résultats dans l'ordre de
+// la table, la chronologie et les compteurs des mesures, que les deux autres
+// ne suffisent pas à retrouver (une élection sans durée ne laisse pas de
+// segment). Une charge ou des paramètres modifiés donnent une autre clé :
+// rien n'est jamais à invalider à la main.
+class ResultCache
+{
+private:
+    std::string directory;
+
+    // Un compteur 64 bits par ligne, en deux moitiés : -1 pour les
+    // changements de contexte, d pour le temps de service du périphérique d
+    static constexpr const char *counterColumns[] = {"counter", "high", "low"};
+    static constexpr size_t counterColumnCount = 3;
+    static constexpr int32_t contextSwitchCounter = -1;
+
+    std::string path(uint64_t key, const char *kind) const
+    {
+        char name[40];
+        std::snprintf(name, sizeof(name), "/%016" PRIx64 ".%s.ordc", key, kind);
+        return directory + name;
+    }
+
+    // Crée le répertoire et ses parents au besoin
+    static bool makeDirectories(const std::string &path)
+    {
+        for (size_t slash = path.find('/', 1); ; slash = path.find('/', slash + 1))
+        {
+            std::string prefix = path.substr(0, slash);
+            if (::mkdir(prefix.c_str(), 0755) != 0 && errno != EEXIST)
+                return false;
+            if (slash == std::string::npos)
+                return true;
+        }
+    }
+
+    // Écrit dans un fichier temporaire puis le renomme : un lecteur ne voit
+    // jamais une entrée à moitié écrite
+    template <typename Fill>
+    bool writeAtomically(const std::string &target, const char *const *columns, size_t count, Fill fill) const
+    {
+        std::string temporary = target + ".tmp" + std::to_string(::getpid());
+        bool ok;
+        {
+            ColumnarRowWriter writer(temporary, columns, count);
+            if (!writer.isOpen())
+                return false;
+            fill(writer);
+            ok = writer.close();
+        }
+        if (!ok || std::rename(temporary.c_str(), target.c_str()) != 0)
+        {
+            std::remove(temporary.c_str());
+            return false;
+        }
+        return true;
+    }
+
+public:
+    explicit ResultCache(const std::string &dir = defaultDirectory()) : directory(dir) {}
+
+    // $XDG_CACHE_HOME/ordonnanceur, ou ~/.cache/ordonnanceur
+    static std::string defaultDirectory()
+    {
+        if (const char *cache = std::getenv("XDG_CACHE_HOME"); cache != nullptr && *cache != '\0')
+            return std::string(cache) + "/ordonnanceur";
+        if (const char *home = std::getenv("HOME"); home != nullptr && *home != '\0')
+            return std::string(home) + "/.cache/ordonnanceur";
+        return "/tmp/ordonnanceur";
+    }
+
+    // Clé d'une simulation ; la table doit être triée par date d'arrivée,
+    // comme le fait Simulator::run(). Les noms n'interviennent pas.
+    static uint64_t key(const ProcessTable &processes, const std::string &policy, const PolicyOptions &options)
+    {
+        const PolicyEntry *entry = findPolicy(policy);
+        Fingerprint fingerprint;
+        fingerprint.add(resultCacheVersion);
+        fingerprint.add(entry != nullptr ? entry->name : policy);
+        // Le quantum des politiques qui l'ignorent ne change pas la clé
+        bool usesQuantum = entry == nullptr || entry->usesQuantum;
+        for (int value : {usesQuantum ? options.quantum : 0, options.levels, options.boostInterval,
+                          options.targetLatency, options.minGranularity})
+            fingerprint.add(uint32_t(value));
+        fingerprint.add(processes.pid);
+        fingerprint.add(processes.arrivalTime);
+        fingerprint.add(processes.burstTime);
+        fingerprint.add(processes.priority);
+        // Les charges sans entrée-sortie gardent leurs clés d'avant les séquences de rafales
+        for (size_t i = 0; processes.hasIo() && i < processes.size(); ++i)
+        {
+            fingerprint.add(processes.ioCount[i]);
+            for (uint32_t k = 0; k < processes.ioCount[i]; ++k)
+            {
+                const IoBurst &io = processes.ioBursts[processes.ioFirst[i] + k];
+                fingerprint.add(uint64_t(uint32_t(io.device)) << 32 | uint32_t(io.ioTime));
+                fingerprint.add(uint32_t(io.cpuTime));
+            }
+        }
+        return fingerprint.value();
+    }
+
+    // Remplit les colonnes de résultats de processes, la chronologie et les
+    // mesures depuis l'entrée key, comme si la simulation venait d'avoir
+    // lieu. false si elle n'existe pas ou ne correspond pas à la table
+    // (collision d'empreintes) : la table est alors inchangée.
+    bool load(uint64_t key, ProcessTable &processes, Timeline &timeline, Metrics &metrics) const
+    {
+        ColumnarFile results(path(key, "results"));
+        ColumnarFile segments(path(key, "timeline"));
+        ColumnarFile counters(path(key, "metrics"));
+        if (!results.isOpen() || !segments.isOpen() || !counters.isOpen() ||
+            results.columns() != processColumnCount || segments.columns() != segmentColumnCount ||
+            counters.columns() != counterColumnCount || results.rows() != processes.size())
+            return false;
+
+        int64_t contextSwitches = -1;
+        std::vector<int64_t> deviceBusyTime;
+        for (size_t b = 0; b < counters.batches(); ++b)
+        {
+            for (size_t i = 0; i < counters.batchRows(b); ++i)
+            {
+                int32_t counter = counters.column(b, 0)[i];
+                int64_t value = int64_t(uint64_t(uint32_t(counters.column(b, 1)[i])) << 32 |
+                                        uint32_t(counters.column(b, 2)[i]));
+                if (counter == contextSwitchCounter)
+                {
+                    contextSwitches = value;
+                }
+                else if (counter >= 0)
+                {
+                    if (static_cast<size_t>(counter) >= deviceBusyTime.size())
+                        deviceBusyTime.resize(counter + 1, 0);
+                    deviceBusyTime[counter] = value;
+                }
+            }
+        }
+        if (contextSwitches < 0)
+            return false;
+
+        // Mêmes colonnes que exportResults() : pid, arrivée, durée, priorité, puis les résultats
+        size_t row = 0;
+        for (size_t b = 0; b < results.batches(); ++b)
+        {
+            size_t rows = results.batchRows(b);
+            for (size_t i = 0; i < rows; ++i)
+            {
+                if (results.column(b, 0)[i] != processes.pid[row + i] ||
+                    results.column(b, 1)[i] != processes.arrivalTime[row + i] ||
+                    results.column(b, 2)[i] != processes.burstTime[row + i] ||
+                    results.column(b, 3)[i] != processes.priority[row + i])
+                    return false;
+            }
+            row += rows;
+        }
+
+        row = 0;
+        for (size_t b = 0; b < results.batches(); ++b)
+        {
+            size_t rows = results.batchRows(b);
+            std::memcpy(&processes.waitingTime[row], results.column(b, 4), rows * sizeof(int32_t));
+            std::memcpy(&processes.turnaroundTime[row], results.column(b, 5), rows * sizeof(int32_t));
+            std::memcpy(&processes.responseTime[row], results.column(b, 6), rows * sizeof(int32_t));
+            row += rows;
+        }
+        std::fill(processes.remainingTime.begin(), processes.remainingTime.end(), 0);
+
+        timeline.clear();
+        for (size_t b = 0; b < segments.batches(); ++b)
+        {
+            const int32_t *pid = segments.column(b, 0);
+            const int32_t *start = segments.column(b, 1);
+            const int32_t *end = segments.column(b, 2);
+            for (size_t i = 0; i < segments.batchRows(b); ++i)
+                timeline.append(pid[i], start[i], end[i]);
+        }
+
+        metrics.clear();
+        for (size_t i = 0; i < processes.size(); ++i)
+        {
+            metrics.recordCompletion(processes.arrivalTime[i], processes.burstTime[i], processes.waitingTime[i],
+                                     processes.turnaroundTime[i], processes.responseTime[i]);
+        }
+        metrics.contextSwitches = contextSwitches;
+        metrics.deviceBusyTime.assign(deviceBusyTime.begin(), deviceBusyTime.end());
+        return true;
+    }
+
+    // Enregistre les résultats d'une simulation terminée sous la clé key,
+    // avec les mesures qu'elle a relevées
+    bool store(uint64_t key, const ProcessTable &processes, const Timeline &timeline, const Metrics &metrics) const
+    {
+        if (!makeDirectories(directory))
+            return false;
+        // Les résultats en dernier : load() exige les trois fichiers
+        return writeAtomically(path(key, "metrics"), counterColumns, counterColumnCount,
+                               [&](RowWriter &writer)
+                               {
+                                   auto write = [&](int32_t counter, int64_t value)
+                                   {
+                                       int32_t row[] = {counter, int32_t(uint32_t(uint64_t(value) >> 32)),
+                                                        int32_t(uint32_t(value))};
+                                       writer.write(row);
+                                   };
+                                   write(contextSwitchCounter, metrics.contextSwitches);
+                                   for (size_t d = 0; d < metrics.deviceBusyTime.size(); ++d)
+                                       write(static_cast<int32_t>(d), metrics.deviceBusyTime[d]);
+                               }) &&
+               writeAtomically(path(key, "timeline"), segmentColumns, segmentColumnCount,
+                               [&](RowWriter &writer)
+                               { exportTimeline(writer, timeline); }) &&
+               writeAtomically(path(key, "results"), processColumns, processColumnCount,
+                               [&](RowWriter &writer)
+                               { exportResults(writer, processes); });
+    }
+};
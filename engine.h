@@ -0,0 +1,231 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "metrics.h"
+#include "policies.h"
+#include "process_table.h"
+#include "simulator.h"
+#include "timeline.h"
+#include "workload.h"
+
+// Politique dont on ne peut plus dériver : le compilateur connaît le type
+// exact de l'objet et appelle directement ses méthodes, sans passer par la
+// table virtuelle, ce qui lui permet de les intégrer à la boucle du moteur
+template <typename Policy>
+class Sealed final : public Policy
+{
+public:
+    using Policy::Policy;
+};
+
+// Simulation d'une table par une politique choisie à l'exécution. Le choix
+// ne coûte qu'un appel virtuel par simulation : la boucle des événements est
+// celle de l'instanciation correspondante.
+class SimulationEngine
+{
+public:
+    virtual ~SimulationEngine() = default;
+
+    virtual void setControl(SimulationControl *control) = 0;
+    virtual void setMetrics(Metrics *metrics) = 0;
+    virtual void setSink(ScheduleSink *sink) = 0;
+    virtual bool cancelled() const = 0;
+
+    // Voir Simulator::run()
+    virtual void run() = 0;
+    virtual bool run(WorkloadSource &trace) = 0;
+};
+
+// Moteur propriétaire de sa politique : Policy est soit une politique
+// scellée (boucle spécialisée), soit SchedulingPolicy (appels virtuels)
+template <typename Policy>
+class PolicyEngine final : public SimulationEngine
+{
+private:
+    std::unique_ptr<Policy> policy;
+    BasicSimulator<Policy> simulator;
+
+public:
+    PolicyEngine(std::unique_ptr<Policy> p, ProcessTable &processes, Timeline *timeline)
+        : policy(std::move(p)), simulator(processes, *policy, timeline) {}
+
+    void setControl(SimulationControl *control) override
+    {
+        simulator.setControl(control);
+    }
+
+    void setMetrics(Metrics *metrics) override
+    {
+        simulator.setMetrics(metrics);
+    }
+
+    void setSink(ScheduleSink *sink) override
+    {
+        simulator.setSink(sink);
+    }
+
+    bool cancelled() const override
+    {
+        return simulator.cancelled();
+    }
+
+    void run() override
+    {
+        simulator.run();
+    }
+
+    bool run(WorkloadSource &trace) override
+    {
+        return simulator.run(trace);
+    }
+};
+
+// Moteur instancié pour la politique Policy, construite avec args
+template <typename Policy, typename... Args>
+std::unique_ptr<SimulationEngine> makeSpecializedEngine(ProcessTable &processes, Timeline *timeline, Args &&...args)
+{
+    return std::make_unique<PolicyEngine<Sealed<Policy>>>(
+        std::make_unique<Sealed<Policy>>(std::forward<Args>(args)...), processes, timeline);
+}
+
+using EngineFactory = std::function<std::unique_ptr<SimulationEngine>(ProcessTable &, Timeline *, const PolicyOptions &)>;
+
+// Instanciation spécialisée d'une politique du registre de policies.h
+struct EngineEntry
+{
+    std::string name;
+    EngineFactory make;
+};
+
+// Les paramètres sont lus comme par les fabriques de policyRegistry()
+inline std::vector<EngineEntry> &engineRegistry()
+{
+    static std::vector<EngineEntry> registry = {
+        {"fcfs", [](ProcessTable &processes, Timeline *timeline, const PolicyOptions &)
+         { return makeSpecializedEngine<FifoPolicy>(processes, timeline); }},
+        {"priority", [](ProcessTable &processes, Timeline *timeline, const PolicyOptions &)
+         { return makeSpecializedEngine<PriorityPolicy>(processes, timeline); }},
+        {"rr", [](ProcessTable &processes, Timeline *timeline, const PolicyOptions &options)
+         { return makeSpecializedEngine<RoundRobinPolicy>(processes, timeline, options.quantum); }},
+        {"sjf", [](ProcessTable &processes, Timeline *timeline, const PolicyOptions &)
+         { return makeSpecializedEngine<SJFPolicy>(processes, timeline); }},
+        {"mlfq", [](ProcessTable &processes, Timeline *timeline, const PolicyOptions &options)
+         { return makeSpecializedEngine<MlfqPolicy>(processes, timeline, options.levels,
+                                                    options.quantum > 0 ? options.quantum : 2,
+                                                    options.boostInterval); }},
+        {"cfs", [](ProcessTable &processes, Timeline *timeline, const PolicyOptions &options)
+         { return makeSpecializedEngine<FairSharePolicy>(processes, timeline, options.targetLatency,
+                                                         options.minGranularity); }},
+    };
+    return registry;
+}
+
+// Moteur de la politique name, dont la boucle passe par l'interface virtuelle
+inline std::unique_ptr<SimulationEngine> makeVirtualEngine(const std::string &name, ProcessTable &processes,
+                                                           const PolicyOptions &options, Timeline *timeline = nullptr)
+{
+    std::unique_ptr<SchedulingPolicy> policy = makePolicy(name, options);
+    if (!policy)
+        return nullptr;
+    return std::make_unique<PolicyEngine<SchedulingPolicy>>(std::move(policy), processes, timeline);
+}
+
+// Moteur de la politique name, spécialisé si elle a une instanciation ; une
+// politique seulement ajoutée par registerPolicy() passe par l'interface
+// virtuelle. nullptr si le nom est inconnu.
+inline std::unique_ptr<SimulationEngine> makeEngine(const std::string &name, ProcessTable &processes,
+                                                    const PolicyOptions &options, Timeline *timeline = nullptr)
+{
+    const PolicyEntry *policy = findPolicy(name);
+    if (policy == nullptr)
+        return nullptr;
+    for (const auto &entry : engineRegistry())
+    {
+        if (entry.name == policy->name)
+            return entry.make(processes, timeline, options);
+    }
+    return makeVirtualEngine(policy->name, processes, options, timeline);
+}
+
+// État réutilisable d'une suite de simulations sur une même charge (balayage,
+// répétitions) : la table, la chronologie, les mesures et un moteur par
+// configuration déjà rencontrée sont remis à zéro plutôt que réalloués. Une
+// fois chaque configuration simulée une fois, les simulations suivantes
+// n'allouent plus rien. Les moteurs désignent la table et la chronologie du
+// contexte : il ne se copie ni ne se déplace.
+class SimulationContext
+{
+private:
+    struct CachedEngine
+    {
+        std::string policy;
+        PolicyOptions options;
+        std::unique_ptr<SimulationEngine> engine;
+    };
+
+    ProcessTable processes;
+    Timeline timeline;
+    Metrics metrics;
+    bool recordTimeline;
+    std::vector<CachedEngine> engines;
+
+public:
+    explicit SimulationContext(bool withTimeline = false) : recordTimeline(withTimeline) {}
+    SimulationContext(const SimulationContext &) = delete;
+    SimulationContext &operator=(const SimulationContext &) = delete;
+
+    // Copie la charge dans la table du contexte, en réutilisant sa capacité ;
+    // triée ici, elle n'est plus déplacée par les simulations
+    void load(const ProcessTable &workload)
+    {
+        processes = workload;
+        processes.sortByArrival();
+    }
+
+    // Simule la charge chargée ; false si la politique est inconnue
+    bool run(const std::string &policy, const PolicyOptions &options)
+    {
+        SimulationEngine *engine = nullptr;
+        for (auto &cached : engines)
+        {
+            if (cached.policy == policy && cached.options == options)
+            {
+                engine = cached.engine.get();
+                break;
+            }
+        }
+        if (engine == nullptr)
+        {
+            std::unique_ptr<SimulationEngine> made = makeEngine(policy, processes, options,
+                                                                recordTimeline ? &timeline : nullptr);
+            if (!made)
+                return false;
+            made->setMetrics(&metrics);
+            engine = made.get();
+            engines.push_back({policy, options, std::move(made)});
+        }
+        engine->run();
+        return true;
+    }
+
+    // Résultats de la dernière simulation
+    const ProcessTable &table() const
+    {
+        return processes;
+    }
+
+    const Timeline &lastTimeline() const
+    {
+        return timeline;
+    }
+
+    const Metrics &lastMetrics() const
+    {
+        return metrics;
+    }
+};
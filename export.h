@@ -0,0 +1,545 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "process_table.h"
+#include "simulator.h"
+#include "timeline.h"
+
+// Colonnes des tables exportées
+constexpr const char *processColumns[] = {"pid", "arrival", "burst", "priority", "waiting", "turnaround", "response"};
+constexpr const char *segmentColumns[] = {"pid", "start", "end"};
+constexpr size_t processColumnCount = sizeof(processColumns) / sizeof(processColumns[0]);
+constexpr size_t segmentColumnCount = sizeof(segmentColumns) / sizeof(segmentColumns[0]);
+
+// Table exportée ligne par ligne : des colonnes entières nommées, fixées à
+// l'ouverture. Les lignes sont écrites par blocs, sans être conservées.
+class RowWriter
+{
+protected:
+    std::FILE *file = nullptr;
+    std::vector<std::string> names;
+    bool failed = false;
+
+    bool writeBytes(const void *data, size_t size)
+    {
+        if (size > 0 && std::fwrite(data, 1, size, file) != size)
+            failed = true;
+        return !failed;
+    }
+
+    // Termine le fichier avant sa fermeture (bloc en cours, pied de page)
+    virtual void finish() {}
+
+public:
+    RowWriter(const std::string &path, const char *const *columns, size_t count)
+        : names(columns, columns + count)
+    {
+        file = path == "-" ? stdout : std::fopen(path.c_str(), "wb");
+        if (file != nullptr)
+            std::setvbuf(file, nullptr, _IOFBF, 1 << 20);
+    }
+
+    // Les classes dérivées ferment le fichier dans leur propre destructeur,
+    // tant que finish() peut encore être appelée
+    virtual ~RowWriter() = default;
+
+    RowWriter(const RowWriter &) = delete;
+    RowWriter &operator=(const RowWriter &) = delete;
+
+    bool isOpen() const
+    {
+        return file != nullptr;
+    }
+
+    size_t columns() const
+    {
+        return names.size();
+    }
+
+    // values : une valeur par colonne
+    virtual void write(const int32_t *values) = 0;
+
+    bool close()
+    {
+        if (file == nullptr)
+            return false;
+        finish();
+        bool ok = (file == stdout ? std::fflush(file) : std::fclose(file)) == 0 && !failed;
+        file = nullptr;
+        return ok;
+    }
+};
+
+// Texte : les nombres sont formatés dans un tampon, sans flux ni allocation
+class TextRowWriter : public RowWriter
+{
+private:
+    char buffer[1 << 16];
+    size_t used = 0;
+
+protected:
+    void put(const char *text, size_t size)
+    {
+        if (used + size > sizeof(buffer))
+        {
+            writeBytes(buffer, used);
+            used = 0;
+        }
+        std::memcpy(buffer + used, text, size);
+        used += size;
+    }
+
+    void put(const char *text)
+    {
+        put(text, std::strlen(text));
+    }
+
+    void put(int32_t value)
+    {
+        char digits[12];
+        char *end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+        put(digits, end - digits);
+    }
+
+    void finish() override
+    {
+        writeBytes(buffer, used);
+        used = 0;
+    }
+
+public:
+    using RowWriter::RowWriter;
+};
+
+// CSV avec une ligne d'en-tête
+class CsvRowWriter final : public TextRowWriter
+{
+public:
+    CsvRowWriter(const std::string &path, const char *const *columns, size_t count)
+        : TextRowWriter(path, columns, count)
+    {
+        for (size_t c = 0; c < names.size(); ++c)
+        {
+            if (c > 0)
+                put(",");
+            put(names[c].c_str());
+        }
+        put("\n");
+    }
+
+    ~CsvRowWriter() override
+    {
+        close();
+    }
+
+    void write(const int32_t *values) override
+    {
+        for (size_t c = 0; c < names.size(); ++c)
+        {
+            if (c > 0)
+                put(",");
+            put(values[c]);
+        }
+        put("\n");
+    }
+};
+
+// JSON Lines : un objet par ligne
+class JsonLinesRowWriter final : public TextRowWriter
+{
+private:
+    std::vector<std::string> keys; // "{\"nom\":" puis ",\"nom\":"
+
+public:
+    JsonLinesRowWriter(const std::string &path, const char *const *columns, size_t count)
+        : TextRowWriter(path, columns, count)
+    {
+        for (size_t c = 0; c < names.size(); ++c)
+            keys.push_back((c == 0 ? "{\"" : ",\"") + names[c] + "\":");
+    }
+
+    ~JsonLinesRowWriter() override
+    {
+        close();
+    }
+
+    void write(const int32_t *values) override
+    {
+        for (size_t c = 0; c < keys.size(); ++c)
+        {
+            put(keys[c].c_str(), keys[c].size());
+            put(values[c]);
+        }
+        put("}\n");
+    }
+};
+
+// Format binaire en colonnes : un en-tête, des blocs d'au plus batchRows
+// lignes où chaque colonne est un tableau contigu d'int32 (ordre natif), et
+// un pied de page donnant la position de chaque bloc, à la manière d'Arrow
+// ou de Parquet. Le fichier se projette en mémoire et chaque colonne d'un
+// bloc s'y lit en place.
+//
+//   ColumnarHeader, columnCount noms de 16 octets
+//   bloc : ColumnarBatch, puis columnCount × rows int32
+//   pied : bourrage jusqu'à un multiple de 8 octets, batchCount positions
+//          uint64, puis ColumnarTrailer
+struct ColumnarHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t columnCount;
+    uint32_t batchRows;
+};
+
+struct ColumnarBatch
+{
+    uint32_t rows;
+    uint32_t reserved;
+};
+
+struct ColumnarTrailer
+{
+    uint64_t batchCount;
+    uint64_t rowCount;
+    char magic[4];
+    uint32_t version;
+};
+
+static_assert(sizeof(ColumnarHeader) == 16 && sizeof(ColumnarBatch) == 8 && sizeof(ColumnarTrailer) == 24,
+              "la disposition du format en colonnes ne doit pas changer");
+
+constexpr char columnarMagic[4] = {'O', 'R', 'D', 'C'};
+constexpr uint32_t columnarVersion = 1;
+constexpr size_t columnarNameSize = 16;
+
+class ColumnarRowWriter final : public RowWriter
+{
+private:
+    uint32_t batchRows;
+    std::vector<std::vector<int32_t>> batch; // une colonne par vecteur
+    std::vector<uint64_t> offsets;
+    uint64_t position = 0;
+    uint64_t rowCount = 0;
+
+    void emit(const void *data, size_t size)
+    {
+        writeBytes(data, size);
+        position += size;
+    }
+
+    void flushBatch()
+    {
+        if (batch.empty() || batch[0].empty())
+            return;
+        offsets.push_back(position);
+        ColumnarBatch header = {static_cast<uint32_t>(batch[0].size()), 0};
+        emit(&header, sizeof(header));
+        for (auto &column : batch)
+        {
+            emit(column.data(), column.size() * sizeof(int32_t));
+            column.clear();
+        }
+    }
+
+    void finish() override
+    {
+        flushBatch();
+        const char padding[sizeof(uint64_t)] = {};
+        emit(padding, (sizeof(uint64_t) - position % sizeof(uint64_t)) % sizeof(uint64_t));
+        emit(offsets.data(), offsets.size() * sizeof(uint64_t));
+        ColumnarTrailer trailer = {offsets.size(), rowCount,
+                                   {columnarMagic[0], columnarMagic[1], columnarMagic[2], columnarMagic[3]},
+                                   columnarVersion};
+        emit(&trailer, sizeof(trailer));
+    }
+
+public:
+    ColumnarRowWriter(const std::string &path, const char *const *columns, size_t count,
+                      uint32_t rowsPerBatch = 1 << 16)
+        : RowWriter(path, columns, count), batchRows(std::max<uint32_t>(1, rowsPerBatch)), batch(count)
+    {
+        for (auto &column : batch)
+            column.reserve(batchRows);
+        if (file == nullptr)
+            return;
+
+        ColumnarHeader header = {{columnarMagic[0], columnarMagic[1], columnarMagic[2], columnarMagic[3]},
+                                 columnarVersion, static_cast<uint32_t>(count), batchRows};
+        emit(&header, sizeof(header));
+        for (const auto &name : names)
+        {
+            char padded[columnarNameSize] = {};
+            std::memcpy(padded, name.data(), std::min(name.size(), columnarNameSize - 1));
+            emit(padded, sizeof(padded));
+        }
+    }
+
+    ~ColumnarRowWriter() override
+    {
+        close();
+    }
+
+    void write(const int32_t *values) override
+    {
+        for (size_t c = 0; c < batch.size(); ++c)
+            batch[c].push_back(values[c]);
+        rowCount++;
+        if (batch[0].size() == batchRows)
+            flushBatch();
+    }
+};
+
+// Fichier en colonnes projeté en mémoire, en lecture seule
+class ColumnarFile
+{
+private:
+    void *mapping = MAP_FAILED;
+    size_t length = 0;
+    const ColumnarHeader *header = nullptr;
+    const uint64_t *offsets = nullptr;
+    const ColumnarTrailer *trailer = nullptr;
+    std::string message;
+
+    bool fail(const std::string &text)
+    {
+        message = text;
+        header = nullptr;
+        return false;
+    }
+
+    bool validate(const std::string &path)
+    {
+        const char *base = static_cast<const char *>(mapping);
+        if (length < sizeof(ColumnarHeader) + sizeof(ColumnarTrailer))
+            return fail(path + " : fichier en colonnes tronqué");
+        header = reinterpret_cast<const ColumnarHeader *>(base);
+        trailer = reinterpret_cast<const ColumnarTrailer *>(base + length - sizeof(ColumnarTrailer));
+        if (std::memcmp(header->magic, columnarMagic, 4) != 0 || header->version != columnarVersion ||
+            std::memcmp(trailer->magic, columnarMagic, 4) != 0 || trailer->version != columnarVersion)
+            return fail(path + " : en-tête de fichier en colonnes invalide");
+
+        size_t dataStart = sizeof(ColumnarHeader) + header->columnCount * columnarNameSize;
+        size_t footerSize = sizeof(ColumnarTrailer) + trailer->batchCount * sizeof(uint64_t);
+        if (trailer->batchCount > length / sizeof(uint64_t) || dataStart + footerSize > length)
+            return fail(path + " : pied de page invalide");
+        offsets = reinterpret_cast<const uint64_t *>(base + length - footerSize);
+
+        uint64_t rows = 0;
+        size_t dataEnd = length - footerSize;
+        for (uint64_t b = 0; b < trailer->batchCount; ++b)
+        {
+            if (offsets[b] < dataStart || offsets[b] + sizeof(ColumnarBatch) > dataEnd)
+                return fail(path + " : bloc hors du fichier");
+            uint64_t batchRows = reinterpret_cast<const ColumnarBatch *>(base + offsets[b])->rows;
+            if (offsets[b] + sizeof(ColumnarBatch) + batchRows * header->columnCount * sizeof(int32_t) > dataEnd)
+                return fail(path + " : bloc tronqué");
+            rows += batchRows;
+        }
+        if (rows != trailer->rowCount)
+            return fail(path + " : nombre de lignes incohérent");
+        return true;
+    }
+
+public:
+    explicit ColumnarFile(const std::string &path)
+    {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            fail("impossible d'ouvrir " + path);
+            return;
+        }
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size > 0)
+        {
+            length = info.st_size;
+            mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        ::close(fd);
+        if (mapping == MAP_FAILED)
+        {
+            fail(path + " : fichier en colonnes illisible");
+            return;
+        }
+        validate(path);
+    }
+
+    ~ColumnarFile()
+    {
+        if (mapping != MAP_FAILED)
+            munmap(mapping, length);
+    }
+
+    ColumnarFile(const ColumnarFile &) = delete;
+    ColumnarFile &operator=(const ColumnarFile &) = delete;
+
+    bool isOpen() const
+    {
+        return header != nullptr;
+    }
+
+    const std::string &error() const
+    {
+        return message;
+    }
+
+    size_t columns() const
+    {
+        return header->columnCount;
+    }
+
+    // Nom de la colonne c, sans les octets de bourrage
+    std::string columnName(size_t c) const
+    {
+        const char *name = reinterpret_cast<const char *>(header + 1) + c * columnarNameSize;
+        return std::string(name, strnlen(name, columnarNameSize));
+    }
+
+    // Indice de la colonne nommée name, columns() si elle n'existe pas
+    size_t columnIndex(const std::string &name) const
+    {
+        for (size_t c = 0; c < columns(); ++c)
+        {
+            if (columnName(c) == name)
+                return c;
+        }
+        return columns();
+    }
+
+    uint64_t rows() const
+    {
+        return trailer->rowCount;
+    }
+
+    size_t batches() const
+    {
+        return trailer->batchCount;
+    }
+
+    size_t batchRows(size_t batch) const
+    {
+        return reinterpret_cast<const ColumnarBatch *>(static_cast<const char *>(mapping) + offsets[batch])->rows;
+    }
+
+    // Valeurs de la colonne c dans le bloc batch : batchRows(batch) int32
+    const int32_t *column(size_t batch, size_t c) const
+    {
+        const char *data = static_cast<const char *>(mapping) + offsets[batch] + sizeof(ColumnarBatch);
+        return reinterpret_cast<const int32_t *>(data) + c * batchRows(batch);
+    }
+};
+
+// Ouvre une table exportée dans le format désigné par l'extension de path :
+// .csv, .jsonl ou .ordc (en colonnes) ; nullptr si l'extension est inconnue
+inline std::unique_ptr<RowWriter> openRowWriter(const std::string &path, const char *const *columns, size_t count)
+{
+    auto endsWith = [&](const char *suffix)
+    {
+        size_t size = std::strlen(suffix);
+        return path.size() >= size && path.compare(path.size() - size, size, suffix) == 0;
+    };
+    if (endsWith(".csv"))
+        return std::make_unique<CsvRowWriter>(path, columns, count);
+    if (endsWith(".jsonl"))
+        return std::make_unique<JsonLinesRowWriter>(path, columns, count);
+    if (endsWith(".ordc"))
+        return std::make_unique<ColumnarRowWriter>(path, columns, count);
+    return nullptr;
+}
+
+// Écrit les résultats par processus et la chronologie au fil de la
+// simulation. Comme Timeline, un segment qui prolonge immédiatement le
+// précédent du même processus lui est fusionné : seul le dernier segment
+// est gardé en mémoire.
+class ScheduleExporter : public ScheduleSink
+{
+private:
+    RowWriter *results;
+    RowWriter *timeline;
+    Segment pending = {0, 0, 0};
+    bool hasPending = false;
+
+    void flushSegment()
+    {
+        if (!hasPending)
+            return;
+        int32_t values[segmentColumnCount] = {pending.pid, pending.start, pending.end};
+        timeline->write(values);
+        hasPending = false;
+    }
+
+public:
+    // Chacune des deux tables est facultative (nullptr)
+    ScheduleExporter(RowWriter *resultsWriter, RowWriter *timelineWriter)
+        : results(resultsWriter), timeline(timelineWriter) {}
+
+    ~ScheduleExporter() override
+    {
+        finish();
+    }
+
+    void segment(int pid, int start, int end) override
+    {
+        if (timeline == nullptr)
+            return;
+        if (hasPending && pending.pid == pid && pending.end == start)
+        {
+            pending.end = end;
+            return;
+        }
+        flushSegment();
+        pending = {pid, start, end};
+        hasPending = true;
+    }
+
+    void completed(const Completion &c) override
+    {
+        if (results == nullptr)
+            return;
+        int32_t values[processColumnCount] = {c.pid, c.arrivalTime, c.burstTime, c.priority,
+                                              c.waitingTime, c.turnaroundTime, c.responseTime};
+        results->write(values);
+    }
+
+    // Écrit le segment en attente ; à appeler en fin de simulation
+    void finish()
+    {
+        flushSegment();
+    }
+};
+
+// Exporte les résultats d'une table déjà simulée, dans l'ordre de la table
+inline void exportResults(RowWriter &writer, const ProcessTable &processes)
+{
+    for (size_t i = 0; i < processes.size(); ++i)
+    {
+        int32_t values[processColumnCount] = {processes.pid[i], processes.arrivalTime[i], processes.burstTime[i],
+                                              processes.priority[i], processes.waitingTime[i],
+                                              processes.turnaroundTime[i], processes.responseTime[i]};
+        writer.write(values);
+    }
+}
+
+inline void exportTimeline(RowWriter &writer, const Timeline &timeline)
+{
+    for (size_t i = 0; i < timeline.size(); ++i)
+    {
+        int32_t values[segmentColumnCount] = {timeline[i].pid, timeline[i].start, timeline[i].end};
+        writer.write(values);
+    }
+}
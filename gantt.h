@@ -0,0 +1,127 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include "process_table.h"
+#include "timeline.h"
+
+// Index du diagramme de Gantt : les segments de la chronologie regroupés par
+// rangée (une rangée par processus, dans l'ordre de la table) et triés par
+// date, pour ne parcourir que ceux qui coupent la fenêtre visible.
+class GanttIndex
+{
+private:
+    std::vector<size_t> rowBegin; // segments de la rangée r : [rowBegin[r], rowBegin[r + 1])
+    std::vector<int> starts;
+    std::vector<int> ends;
+    int endTime = 0;
+
+public:
+    void build(const ProcessTable &processes, const Timeline &timeline)
+    {
+        std::unordered_map<int, size_t> rowOfPid;
+        rowOfPid.reserve(processes.size());
+        for (size_t p = 0; p < processes.size(); ++p)
+        {
+            rowOfPid[processes.pid[p]] = p;
+        }
+
+        // Tri par dénombrement : les segments d'un même processus sont déjà
+        // dans l'ordre chronologique dans la chronologie
+        std::vector<size_t> rows(timeline.size());
+        rowBegin.assign(processes.size() + 1, 0);
+        for (size_t s = 0; s < timeline.size(); ++s)
+        {
+            rows[s] = rowOfPid[timeline[s].pid];
+            rowBegin[rows[s] + 1]++;
+        }
+        for (size_t r = 0; r < processes.size(); ++r)
+        {
+            rowBegin[r + 1] += rowBegin[r];
+        }
+
+        std::vector<size_t> next(rowBegin.begin(), rowBegin.end() - 1);
+        starts.resize(timeline.size());
+        ends.resize(timeline.size());
+        for (size_t s = 0; s < timeline.size(); ++s)
+        {
+            size_t slot = next[rows[s]]++;
+            starts[slot] = timeline[s].start;
+            ends[slot] = timeline[s].end;
+        }
+
+        endTime = 0;
+        for (size_t p = 0; p < processes.size(); ++p)
+        {
+            endTime = std::max(endTime, processes.arrivalTime[p] + processes.turnaroundTime[p]);
+        }
+    }
+
+    void clear()
+    {
+        rowBegin.clear();
+        starts.clear();
+        ends.clear();
+        endTime = 0;
+    }
+
+    size_t rows() const
+    {
+        return rowBegin.empty() ? 0 : rowBegin.size() - 1;
+    }
+
+    // Dernière date de fin d'exécution
+    int horizon() const
+    {
+        return endTime;
+    }
+
+    // Appelle draw(début, fin) pour chaque bloc d'exécution de la rangée row
+    // qui coupe [from, to). Les segments séparés de moins de minGap (la durée
+    // d'un pixel) sont fusionnés : le nombre de blocs est borné par la largeur
+    // de la fenêtre en pixels, quel que soit le nombre de segments.
+    template <typename Draw>
+    void forEachRun(size_t row, double from, double to, double minGap, Draw draw) const
+    {
+        auto last = starts.begin() + rowBegin[row + 1];
+
+        // Premier segment qui finit après from (les fins croissent avec les débuts)
+        size_t i = std::upper_bound(ends.begin() + rowBegin[row], ends.begin() + rowBegin[row + 1], from) - ends.begin();
+        while (i < rowBegin[row + 1] && starts[i] < to)
+        {
+            int runStart = starts[i];
+            int runEnd = ends[i];
+            size_t next = i + 1;
+            while (true)
+            {
+                // Tous les segments qui débutent moins de minGap après la fin du bloc
+                size_t merged = std::lower_bound(starts.begin() + next, last, runEnd + minGap) - starts.begin();
+                if (merged == next)
+                    break;
+                runEnd = std::max(runEnd, ends[merged - 1]);
+                next = merged;
+            }
+            draw(runStart, runEnd);
+            i = next;
+        }
+    }
+};
+
+// Pas de graduation du temps : la plus petite valeur 1, 2 ou 5 × 10^k
+// supérieure ou égale à minimum (jamais moins d'une unité de temps)
+inline double ganttTickStep(double minimum)
+{
+    double step = 1;
+    while (true)
+    {
+        for (double factor : {1.0, 2.0, 5.0})
+        {
+            if (step * factor >= minimum)
+                return step * factor;
+        }
+        step *= 10;
+    }
+}
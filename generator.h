@@ -0,0 +1,121 @@
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <random>
+
+#include "process_table.h"
+
+// Paramètres d'une charge synthétique : arrivées poissonniennes, durées
+// exponentielles ou à queue lourde (Pareto), priorités uniformes. Avec des
+// périphériques, chaque processus fait un nombre uniforme d'entrées-sorties
+// de durées exponentielles, chacune suivie d'une rafale de même loi que la
+// première.
+struct WorkloadSpec
+{
+    enum BurstDistribution
+    {
+        Exponential,
+        Pareto
+    };
+
+    size_t count = 1000;
+    double meanInterarrival = 5.0;
+    BurstDistribution burstDistribution = Exponential;
+    double meanBurst = 4.0;
+    double paretoShape = 1.5; // > 1 pour que la moyenne existe
+    int priorityLevels = 10;
+    int ioDevices = 0;         // 0 : aucune entrée-sortie
+    double meanIoBursts = 2.0; // entrées-sorties par processus, en moyenne
+    double meanIoTime = 10.0;
+    uint64_t seed = 1;
+};
+
+// Tirages reproductibles d'une plateforme à l'autre : mt19937_64 est
+// entièrement spécifié, contrairement aux distributions de <random>,
+// d'où les inversions de fonction de répartition écrites à la main.
+class WorkloadRandom
+{
+private:
+    std::mt19937_64 engine;
+
+public:
+    explicit WorkloadRandom(uint64_t seed) : engine(seed) {}
+
+    // Uniforme dans [0, 1)
+    double uniform()
+    {
+        return (engine() >> 11) * 0x1.0p-53;
+    }
+
+    double exponential(double mean)
+    {
+        return -mean * std::log1p(-uniform());
+    }
+
+    // Pareto de forme shape, d'échelle choisie pour obtenir la moyenne demandée
+    double pareto(double mean, double shape)
+    {
+        double scale = mean * (shape - 1) / shape;
+        return scale / std::pow(1 - uniform(), 1 / shape);
+    }
+
+    int below(int bound)
+    {
+        return static_cast<int>(uniform() * bound);
+    }
+};
+
+// Graine du flux numéro stream dérivé de seed (splitmix64) : des flux voisins
+// donnent des suites sans rapport, et chaque tirage d'une expérience se
+// reproduit seul, quel que soit le fil qui le fait
+inline uint64_t streamSeed(uint64_t seed, uint64_t stream)
+{
+    uint64_t x = seed + (stream + 1) * 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+// Ajoute spec.count processus à la table, triés par date d'arrivée
+inline void generateWorkload(const WorkloadSpec &spec, ProcessTable &processes)
+{
+    WorkloadRandom random(spec.seed);
+    processes.reserve(processes.size() + spec.count);
+
+    auto drawBurst = [&]()
+    {
+        return spec.burstDistribution == WorkloadSpec::Pareto ? random.pareto(spec.meanBurst, spec.paretoShape)
+                                                              : random.exponential(spec.meanBurst);
+    };
+    auto toDuration = [](double value, int limit)
+    {
+        return static_cast<int>(std::clamp(std::round(value), 1.0, static_cast<double>(limit)));
+    };
+
+    double clock = 0;
+    for (size_t i = 0; i < spec.count; ++i)
+    {
+        clock += random.exponential(spec.meanInterarrival);
+        double burst = drawBurst();
+
+        int arrival = static_cast<int>(std::min(clock, static_cast<double>(INT_MAX / 2)));
+        int duration = toDuration(burst, INT_MAX / 4);
+        processes.add(processes.lastPid() + 1, arrival, duration, random.below(std::max(1, spec.priorityLevels)));
+
+        // Tirés après ceux du processus : sans périphérique, la charge est inchangée
+        if (spec.ioDevices > 0)
+        {
+            int ioCount = random.below(static_cast<int>(2 * spec.meanIoBursts) + 1);
+            int limit = INT_MAX / 4 / std::max(1, ioCount); // temps de calcul total sous INT_MAX / 2
+            for (int k = 0; k < ioCount; ++k)
+            {
+                int device = random.below(spec.ioDevices);
+                int ioTime = toDuration(random.exponential(spec.meanIoTime), limit);
+                processes.addIoBurst(device, ioTime, toDuration(drawBurst(), limit));
+            }
+        }
+    }
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// Tas binaire indexé : chaque élément connaît sa position dans le tas, ce qui
+// permet de le remonter ou de le redescendre quand sa clé change (decrease-key).
+// Les identifiants sont des indices ; la mémoire réservée par reset() couvre
+// [0, capacité) et n'est agrandie que si un identifiant plus grand est inséré.
+template <typename Compare>
+class IndexedHeap
+{
+private:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    std::vector<size_t> heap;
+    std::vector<size_t> position;
+    Compare before;
+
+    void place(size_t slot, size_t id)
+    {
+        heap[slot] = id;
+        position[id] = slot;
+    }
+
+    void siftUp(size_t slot)
+    {
+        size_t id = heap[slot];
+        while (slot > 0)
+        {
+            size_t parent = (slot - 1) / 2;
+            if (!before(id, heap[parent]))
+                break;
+            place(slot, heap[parent]);
+            slot = parent;
+        }
+        place(slot, id);
+    }
+
+    void siftDown(size_t slot)
+    {
+        size_t id = heap[slot];
+        size_t count = heap.size();
+        while (true)
+        {
+            size_t child = 2 * slot + 1;
+            if (child >= count)
+                break;
+            if (child + 1 < count && before(heap[child + 1], heap[child]))
+                child++;
+            if (!before(heap[child], id))
+                break;
+            place(slot, heap[child]);
+            slot = child;
+        }
+        place(slot, id);
+    }
+
+public:
+    explicit IndexedHeap(Compare c = Compare()) : before(c) {}
+
+    void reset(size_t capacity)
+    {
+        heap.clear();
+        heap.reserve(capacity);
+        position.assign(capacity, npos);
+    }
+
+    Compare &compare()
+    {
+        return before;
+    }
+
+    const Compare &compare() const
+    {
+        return before;
+    }
+
+    bool empty() const
+    {
+        return heap.empty();
+    }
+
+    size_t size() const
+    {
+        return heap.size();
+    }
+
+    bool contains(size_t id) const
+    {
+        return id < position.size() && position[id] != npos;
+    }
+
+    size_t top() const
+    {
+        return heap.front();
+    }
+
+    void push(size_t id)
+    {
+        if (id >= position.size())
+        {
+            position.resize(std::max(id + 1, 2 * position.size()), npos);
+        }
+        heap.push_back(id);
+        siftUp(heap.size() - 1);
+    }
+
+    size_t pop()
+    {
+        size_t id = heap.front();
+        position[id] = npos;
+        size_t last = heap.back();
+        heap.pop_back();
+        if (!heap.empty())
+        {
+            heap.front() = last;
+            siftDown(0);
+        }
+        return id;
+    }
+
+    // À appeler après modification de la clé d'un élément présent
+    void update(size_t id)
+    {
+        size_t slot = position[id];
+        siftUp(slot);
+        siftDown(position[id]);
+    }
+};
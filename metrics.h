@@ -0,0 +1,227 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+// Histogramme à mémoire constante, à la manière de HdrHistogram : valeurs
+// exactes jusqu'à 2 × subBuckets, puis subBuckets cases par puissance de
+// deux, soit une erreur relative inférieure à 1 / subBuckets. Deux
+// histogrammes se fusionnent par simple addition des cases.
+class LatencyHistogram
+{
+private:
+    static constexpr int subBits = 7;
+    static constexpr int64_t subBuckets = int64_t(1) << subBits;
+    static constexpr int bucketCount = (32 - subBits) * subBuckets; // couvre tout int positif
+
+    std::array<uint64_t, bucketCount> counts{};
+    uint64_t total = 0;
+    int64_t sum = 0;
+    int minimum = INT_MAX;
+    int maximum = 0;
+
+    static int bucketOf(int value)
+    {
+        if (value < 2 * subBuckets)
+            return value;
+        int shift = 31 - __builtin_clz(static_cast<unsigned>(value)) - subBits;
+        return static_cast<int>((shift + 1) * subBuckets + (value >> shift) - subBuckets);
+    }
+
+    // Plus grande valeur rangée dans la case bucket
+    static int64_t highestIn(int bucket)
+    {
+        if (bucket < 2 * subBuckets)
+            return bucket;
+        int shift = bucket / subBuckets - 1;
+        int64_t mantissa = bucket % subBuckets + subBuckets;
+        return ((mantissa + 1) << shift) - 1;
+    }
+
+public:
+    // Les valeurs négatives (jamais élu) comptent pour zéro
+    void record(int value)
+    {
+        value = std::max(0, value);
+        counts[bucketOf(value)]++;
+        total++;
+        sum += value;
+        minimum = std::min(minimum, value);
+        maximum = std::max(maximum, value);
+    }
+
+    void merge(const LatencyHistogram &other)
+    {
+        for (int i = 0; i < bucketCount; ++i)
+            counts[i] += other.counts[i];
+        total += other.total;
+        sum += other.sum;
+        minimum = std::min(minimum, other.minimum);
+        maximum = std::max(maximum, other.maximum);
+    }
+
+    void clear()
+    {
+        counts.fill(0);
+        total = 0;
+        sum = 0;
+        minimum = INT_MAX;
+        maximum = 0;
+    }
+
+    uint64_t count() const
+    {
+        return total;
+    }
+
+    double mean() const
+    {
+        return total == 0 ? 0 : static_cast<double>(sum) / total;
+    }
+
+    int min() const
+    {
+        return total == 0 ? 0 : minimum;
+    }
+
+    int max() const
+    {
+        return maximum;
+    }
+
+    // Plus petite valeur v (à la précision des cases) telle qu'au moins une
+    // fraction q des valeurs soit inférieure ou égale à v
+    int64_t percentile(double q) const
+    {
+        if (total == 0)
+            return 0;
+        uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * total)));
+        uint64_t seen = 0;
+        for (int i = 0; i < bucketCount; ++i)
+        {
+            seen += counts[i];
+            if (seen >= rank)
+                return std::clamp<int64_t>(highestIn(i), min(), maximum);
+        }
+        return maximum;
+    }
+};
+
+// Mesures agrégées d'une simulation, relevées au fil des terminaisons :
+// la mémoire ne dépend pas du nombre de processus, et les mesures de
+// plusieurs simulations (balayage, répétitions) se fusionnent.
+struct Metrics
+{
+    LatencyHistogram waiting;
+    LatencyHistogram turnaround;
+    LatencyHistogram response;
+    int64_t busyTime = 0;         // temps processeur consommé
+    int64_t contextSwitches = 0;  // élections d'un autre processus que le précédent
+    std::vector<int64_t> deviceBusyTime; // temps de service de chaque périphérique
+    int firstArrival = INT_MAX;
+    int lastCompletion = 0;
+
+    void recordCompletion(int arrival, int burst, int waitingTime, int turnaroundTime, int responseTime)
+    {
+        waiting.record(waitingTime);
+        turnaround.record(turnaroundTime);
+        response.record(responseTime);
+        busyTime += burst;
+        firstArrival = std::min(firstArrival, arrival);
+        lastCompletion = std::max(lastCompletion, arrival + turnaroundTime);
+    }
+
+    void recordIo(int device, int duration)
+    {
+        if (static_cast<size_t>(device) >= deviceBusyTime.size())
+            deviceBusyTime.resize(device + 1, 0);
+        deviceBusyTime[device] += duration;
+    }
+
+    void merge(const Metrics &other)
+    {
+        waiting.merge(other.waiting);
+        turnaround.merge(other.turnaround);
+        response.merge(other.response);
+        busyTime += other.busyTime;
+        contextSwitches += other.contextSwitches;
+        if (other.deviceBusyTime.size() > deviceBusyTime.size())
+            deviceBusyTime.resize(other.deviceBusyTime.size(), 0);
+        for (size_t d = 0; d < other.deviceBusyTime.size(); ++d)
+            deviceBusyTime[d] += other.deviceBusyTime[d];
+        firstArrival = std::min(firstArrival, other.firstArrival);
+        lastCompletion = std::max(lastCompletion, other.lastCompletion);
+    }
+
+    void clear()
+    {
+        waiting.clear();
+        turnaround.clear();
+        response.clear();
+        busyTime = 0;
+        contextSwitches = 0;
+        deviceBusyTime.clear(); // capacité gardée : pas d'allocation à la simulation suivante
+        firstArrival = INT_MAX;
+        lastCompletion = 0;
+    }
+
+    uint64_t completed() const
+    {
+        return turnaround.count();
+    }
+
+    // Durée entre la première arrivée et la dernière terminaison
+    int64_t makespan() const
+    {
+        return completed() == 0 ? 0 : int64_t(lastCompletion) - firstArrival;
+    }
+
+    // Processus terminés par unité de temps
+    double throughput() const
+    {
+        return makespan() == 0 ? 0 : static_cast<double>(completed()) / makespan();
+    }
+
+    // Fraction du temps où le processeur est occupé (sur plusieurs
+    // processeurs, leur somme : jusqu'au nombre de processeurs). Après fusion de
+    // simulations indépendantes, la période couvre toutes les simulations
+    // et la valeur n'a plus de sens que si elles se suivent dans le temps.
+    double utilization() const
+    {
+        return makespan() == 0 ? 0 : static_cast<double>(busyTime) / makespan();
+    }
+
+    // Fraction du temps où le périphérique device sert une entrée-sortie
+    double deviceUtilization(size_t device) const
+    {
+        return makespan() == 0 || device >= deviceBusyTime.size()
+                   ? 0
+                   : static_cast<double>(deviceBusyTime[device]) / makespan();
+    }
+};
+
+inline void writeMetrics(std::ostream &out, const Metrics &metrics)
+{
+    out << "Metric\t\tMean\tp50\tp95\tp99\tMax\n";
+    auto row = [&](const char *name, const LatencyHistogram &histogram)
+    {
+        out << name << "\t" << histogram.mean() << "\t" << histogram.percentile(0.50) << "\t"
+            << histogram.percentile(0.95) << "\t" << histogram.percentile(0.99) << "\t"
+            << histogram.max() << "\n";
+    };
+    row("Waiting\t", metrics.waiting);
+    row("Turnaround", metrics.turnaround);
+    row("Response", metrics.response);
+    out << "Completed\t" << metrics.completed() << "\n"
+        << "Makespan\t" << metrics.makespan() << "\n"
+        << "Throughput\t" << metrics.throughput() << "\n"
+        << "CPU utilization\t" << metrics.utilization() << "\n"
+        << "Context switches\t" << metrics.contextSwitches << "\n";
+    for (size_t d = 0; d < metrics.deviceBusyTime.size(); ++d)
+        out << "Device " << d << " utilization\t" << metrics.deviceUtilization(d) << "\n";
+}
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "engine.h"
+#include "generator.h"
+#include "metrics.h"
+#include "policies.h"
+#include "process_table.h"
+#include "sweep.h"
+
+// Estimation d'une mesure sur les tirages : moyenne, écart type et
+// demi-largeur de l'intervalle de confiance de la moyenne (loi de Student)
+struct Estimate
+{
+    double mean = 0;
+    double stddev = 0;
+    double halfWidth = 0;
+
+    double low() const
+    {
+        return mean - halfWidth;
+    }
+
+    double high() const
+    {
+        return mean + halfWidth;
+    }
+};
+
+struct MonteCarloResult
+{
+    SweepConfig config;
+    std::vector<Estimate> estimates; // dans l'ordre de monteCarloMetricNames()
+};
+
+// Quantile p de la loi normale centrée réduite (approximation rationnelle
+// d'Acklam, erreur relative inférieure à 1,2e-9)
+inline double normalQuantile(double p)
+{
+    static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                               1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+    static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                               6.680131188771972e+01, -1.328068155288572e+01};
+    static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                               -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+    static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                               3.754408661907416e+00};
+    if (p < 0.02425)
+    {
+        double q = std::sqrt(-2 * std::log(p));
+        return (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+               ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1);
+    }
+    if (p > 1 - 0.02425)
+        return -normalQuantile(1 - p);
+    double q = p - 0.5;
+    double r = q * q;
+    return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+           (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1);
+}
+
+// Quantile p (> 0,5) de la loi de Student à df degrés de liberté : formules
+// exactes pour 1 et 2, développement de Cornish-Fisher au-delà (erreur
+// inférieure à 1 % dès 3 degrés de liberté, négligeable au-delà de 10)
+inline double studentQuantile(double p, size_t df)
+{
+    if (df == 1)
+        return std::tan(std::acos(-1.0) * (p - 0.5));
+    if (df == 2)
+        return (2 * p - 1) / std::sqrt(2 * p * (1 - p));
+    double z = normalQuantile(p);
+    double z2 = z * z;
+    double n = static_cast<double>(df);
+    double g1 = (z2 + 1) * z / 4;
+    double g2 = ((5 * z2 + 16) * z2 + 3) * z / 96;
+    double g3 = (((3 * z2 + 19) * z2 + 17) * z2 - 15) * z / 384;
+    double g4 = ((((79 * z2 + 776) * z2 + 1482) * z2 - 1920) * z2 - 945) * z / 92160;
+    return z + (g1 + (g2 + (g3 + g4 / n) / n) / n) / n;
+}
+
+// Mesures estimées, relevées sur chaque tirage ; avec des entrées-sorties,
+// s'y ajoute l'utilisation de chaque périphérique
+inline std::vector<std::string> monteCarloMetricNames(const WorkloadSpec &spec)
+{
+    std::vector<std::string> names = {"Avg waiting", "Avg turnaround", "Avg response", "P99 waiting",
+                                      "Makespan", "Throughput", "CPU utilization", "Context switches"};
+    for (int d = 0; d < spec.ioDevices; ++d)
+        names.push_back("Device " + std::to_string(d) + " utilization");
+    return names;
+}
+
+// Simule chaque configuration sur samples charges tirées selon spec. La
+// charge numéro s est tirée de son propre flux, streamSeed(spec.seed, s) :
+// elle ne dépend ni du nombre de fils ni de l'ordre dans lequel ils
+// travaillent, et toutes les configurations voient les mêmes charges. Les
+// fils se partagent les tirages ; chacun réutilise sa table et son contexte
+// d'un tirage à l'autre. Les mesures de chaque tirage sont rangées à sa
+// place puis réduites dans l'ordre des tirages : le résultat est le même au
+// bit près pour une même graine, quel que soit le nombre de fils.
+inline std::vector<MonteCarloResult> runMonteCarlo(const WorkloadSpec &spec, size_t samples,
+                                                   const std::vector<SweepConfig> &configs,
+                                                   unsigned threads = std::thread::hardware_concurrency(),
+                                                   const PolicyOptions &options = PolicyOptions(),
+                                                   double confidence = 0.95)
+{
+    size_t metricCount = monteCarloMetricNames(spec).size();
+    // values[(s × configs + c) × mesures + m]
+    std::vector<double> values(samples * configs.size() * metricCount);
+    std::atomic<size_t> nextSample{0};
+
+    auto worker = [&]()
+    {
+        SimulationContext context;
+        ProcessTable workload;
+        WorkloadSpec sampleSpec = spec;
+        size_t sample;
+        while ((sample = nextSample.fetch_add(1, std::memory_order_relaxed)) < samples)
+        {
+            sampleSpec.seed = streamSeed(spec.seed, sample);
+            workload.clear();
+            generateWorkload(sampleSpec, workload);
+            context.load(workload);
+
+            for (size_t c = 0; c < configs.size(); ++c)
+            {
+                PolicyOptions configOptions = options;
+                configOptions.quantum = configs[c].quantum;
+                if (!context.run(configs[c].policy, configOptions))
+                    continue;
+
+                const Metrics &metrics = context.lastMetrics();
+                double *row = &values[(sample * configs.size() + c) * metricCount];
+                row[0] = metrics.waiting.mean();
+                row[1] = metrics.turnaround.mean();
+                row[2] = metrics.response.mean();
+                row[3] = static_cast<double>(metrics.waiting.percentile(0.99));
+                row[4] = static_cast<double>(metrics.makespan());
+                row[5] = metrics.throughput();
+                row[6] = metrics.utilization();
+                row[7] = static_cast<double>(metrics.contextSwitches);
+                for (int d = 0; d < spec.ioDevices; ++d)
+                    row[8 + d] = metrics.deviceUtilization(d);
+            }
+        }
+    };
+
+    threads = std::max(1u, std::min<unsigned>(threads, std::max<size_t>(1, samples)));
+    std::vector<std::thread> pool;
+    for (unsigned i = 1; i < threads; ++i)
+    {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : pool)
+    {
+        thread.join();
+    }
+
+    double t = samples > 1 ? studentQuantile((1 + confidence) / 2, samples - 1) : 0;
+    std::vector<MonteCarloResult> results(configs.size());
+    for (size_t c = 0; c < configs.size(); ++c)
+    {
+        results[c].config = configs[c];
+        results[c].estimates.resize(metricCount);
+        for (size_t m = 0; m < metricCount; ++m)
+        {
+            // Deux passes : la variance ne souffre pas de la soustraction de grands carrés
+            Estimate &estimate = results[c].estimates[m];
+            double sum = 0;
+            for (size_t s = 0; s < samples; ++s)
+                sum += values[(s * configs.size() + c) * metricCount + m];
+            estimate.mean = samples == 0 ? 0 : sum / samples;
+
+            double squares = 0;
+            for (size_t s = 0; s < samples; ++s)
+            {
+                double deviation = values[(s * configs.size() + c) * metricCount + m] - estimate.mean;
+                squares += deviation * deviation;
+            }
+            estimate.stddev = samples > 1 ? std::sqrt(squares / (samples - 1)) : 0;
+            estimate.halfWidth = samples > 1 ? t * estimate.stddev / std::sqrt(static_cast<double>(samples)) : 0;
+        }
+    }
+    return results;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "metrics.h"
+#include "policies.h"
+#include "process_table.h"
+#include "simulator.h"
+#include "workload.h"
+
+// Ordonnanceur alimenté en continu : les processus sont soumis au fil de
+// leur arrivée et l'horloge avance à la demande. Seuls les processus encore
+// dans le système occupent la table ; les terminés sont rendus par
+// pollCompletions() puis oubliés.
+class OnlineScheduler
+{
+private:
+    ProcessTable processes;
+    std::unique_ptr<SchedulingPolicy> policy;
+    Simulator simulator;
+
+public:
+    // metrics, facultatif, reçoit les mesures agrégées de toute la simulation
+    explicit OnlineScheduler(std::unique_ptr<SchedulingPolicy> p, Metrics *metrics = nullptr)
+        : policy(std::move(p)), simulator(processes, *policy)
+    {
+        simulator.setMetrics(metrics);
+        simulator.startOnline();
+    }
+
+    // Reçoit segments et terminaisons au fil de la simulation
+    void setSink(ScheduleSink *sink)
+    {
+        simulator.setSink(sink);
+    }
+
+    OnlineScheduler(const OnlineScheduler &) = delete;
+    OnlineScheduler &operator=(const OnlineScheduler &) = delete;
+
+    // Les arrivées doivent être soumises dans l'ordre, à la date courante ou après
+    bool submit(int pid, int arrivalTime, int burstTime, int priority = 0)
+    {
+        return simulator.submit(pid, arrivalTime, burstTime, priority);
+    }
+
+    bool submit(int pid, const TraceRecord &record)
+    {
+        return submit(pid, record.arrivalTime, record.burstTime, record.priority);
+    }
+
+    // Traite tout ce qui se passe strictement avant time
+    void advanceTo(int time)
+    {
+        simulator.advanceTo(time);
+    }
+
+    void finish()
+    {
+        simulator.finish();
+    }
+
+    size_t pollCompletions(std::vector<Completion> &out)
+    {
+        return simulator.pollCompletions(out);
+    }
+
+    int now() const
+    {
+        return simulator.now();
+    }
+
+    // Processus soumis et pas encore terminés
+    size_t active() const
+    {
+        return simulator.activeCount();
+    }
+};
@@ -0,0 +1,591 @@
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "indexed_heap.h"
+#include "process_table.h"
+#include "ring_queue.h"
+
+// Politique d'ordonnancement : gère la file des prêts et la durée des tranches
+class SchedulingPolicy
+{
+public:
+    virtual ~SchedulingPolicy() = default;
+
+    // Les processus sont désignés par leur indice dans la table de la simulation
+    virtual void push(size_t index) = 0;
+    virtual size_t pop() = 0;
+    virtual bool empty() const = 0;
+
+    // Retire un prêt pour la file d'un autre processeur (vol de travail).
+    // Contrairement à pop(), ne touche pas à ce que la politique retient de
+    // l'élu en cours, qui continue de s'exécuter
+    virtual size_t steal()
+    {
+        return pop();
+    }
+
+    // Appelée une fois par simulation, avant la première arrivée ; la table
+    // peut encore grandir si la charge est lue au fil de l'eau
+    virtual void attach(ProcessTable &/*table*/) {}
+
+    // Signale qu'un processus en attente a changé de priorité ou de temps restant
+    virtual void update(size_t /*index*/) {}
+
+    // Date de l'élection à venir, donnée juste avant pop() aux politiques
+    // qui font vieillir les attentes
+    virtual void advance(int /*currentTime*/) {}
+
+    // L'élu quitte le processeur pour une entrée-sortie, sans passer par la
+    // file ; il y reviendra par push() à son réveil, avec sa rafale suivante
+    virtual void block(size_t /*index*/) {}
+
+    // Vrai si le nouvel arrivant (ou le processus réveillé) doit prendre le processeur à l'élu
+    virtual bool preempts(size_t /*arrived*/, size_t /*running*/) const
+    {
+        return false;
+    }
+
+    // Durée pendant laquelle le processus élu garde le processeur
+    virtual int timeSlice(int remainingTime) const
+    {
+        return remainingTime;
+    }
+};
+
+class FifoPolicy : public SchedulingPolicy
+{
+private:
+    RingQueue<size_t> readyQueue;
+
+public:
+    // File vidée des restes d'une simulation interrompue
+    void attach(ProcessTable &) override
+    {
+        readyQueue.clear();
+    }
+
+    void push(size_t index) override
+    {
+        readyQueue.push_back(index);
+    }
+
+    size_t pop() override
+    {
+        size_t index = readyQueue.front();
+        readyQueue.pop_front();
+        return index;
+    }
+
+    bool empty() const override
+    {
+        return readyQueue.empty();
+    }
+};
+
+class RoundRobinPolicy : public FifoPolicy
+{
+private:
+    int quantum;
+
+public:
+    explicit RoundRobinPolicy(int q) : quantum(q) {}
+
+    int timeSlice(int remainingTime) const override
+    {
+        // Quantum non renseigné : pas de découpage
+        if (quantum <= 0)
+        {
+            return remainingTime;
+        }
+        return std::min(quantum, remainingTime);
+    }
+};
+
+// Plus petit temps restant d'abord, puis ordre d'arrivée
+struct ShortestRemainingFirst
+{
+    bool operator()(const ProcessTable &table, size_t a, size_t b) const
+    {
+        if (table.remainingTime[a] != table.remainingTime[b])
+            return table.remainingTime[a] < table.remainingTime[b];
+        if (table.arrivalTime[a] != table.arrivalTime[b])
+            return table.arrivalTime[a] < table.arrivalTime[b];
+        return table.pid[a] < table.pid[b];
+    }
+};
+
+// Plus petite valeur de priorité d'abord, puis ordre d'arrivée
+struct HighestPriorityFirst
+{
+    bool operator()(const ProcessTable &table, size_t a, size_t b) const
+    {
+        if (table.priority[a] != table.priority[b])
+            return table.priority[a] < table.priority[b];
+        if (table.arrivalTime[a] != table.arrivalTime[b])
+            return table.arrivalTime[a] < table.arrivalTime[b];
+        return table.pid[a] < table.pid[b];
+    }
+};
+
+template <typename Key>
+class HeapPolicy : public SchedulingPolicy
+{
+private:
+    struct ByKey
+    {
+        const ProcessTable *table = nullptr;
+
+        bool operator()(size_t a, size_t b) const
+        {
+            return Key()(*table, a, b);
+        }
+    };
+
+    IndexedHeap<ByKey> readyQueue;
+
+public:
+    void attach(ProcessTable &table) override
+    {
+        readyQueue.compare().table = &table;
+        readyQueue.reset(std::max(table.size(), table.pid.capacity()));
+    }
+
+    void push(size_t index) override
+    {
+        readyQueue.push(index);
+    }
+
+    size_t pop() override
+    {
+        return readyQueue.pop();
+    }
+
+    bool empty() const override
+    {
+        return readyQueue.empty();
+    }
+
+    bool preempts(size_t arrived, size_t running) const override
+    {
+        return readyQueue.compare()(arrived, running);
+    }
+
+    void update(size_t index) override
+    {
+        if (readyQueue.contains(index))
+        {
+            readyQueue.update(index);
+        }
+    }
+};
+
+using SJFPolicy = HeapPolicy<ShortestRemainingFirst>;
+using PriorityPolicy = HeapPolicy<HighestPriorityFirst>;
+
+// Files multiniveaux à rétroaction (MLFQ) : un arrivant entre au niveau 0 ;
+// qui consomme toute sa tranche descend d'un niveau, dont le quantum double.
+// Tous les boostInterval, chacun remonte au niveau 0 contre la famine. Un
+// arrivant préempte l'élu d'un niveau inférieur.
+//
+// La tranche de l'élu est celle du niveau d'où pop() vient de le tirer ;
+// steal() retire le prochain prêt sans toucher à cette tranche. Sur plusieurs
+// processeurs, chaque file a sa propre mémoire des niveaux : un processus
+// volé reprend au niveau que lui connaît la file voleuse (0 par défaut).
+class MlfqPolicy : public SchedulingPolicy
+{
+private:
+    static constexpr size_t none = static_cast<size_t>(-1);
+
+    std::vector<RingQueue<size_t>> queues;
+    std::vector<int> quantums;
+    int boostInterval;
+    int64_t nextBoost = 0;
+    const ProcessTable *table = nullptr;
+
+    // Niveau de chaque processus, valable pour la remontée (epoch) où il a été fixé
+    std::vector<int> levelOf;
+    std::vector<uint32_t> epochOf;
+    uint32_t epoch = 1;
+
+    size_t popped = none;
+    int remainingAtPop = 0;
+    int slice = 0;
+
+    int level(size_t index) const
+    {
+        return index < levelOf.size() && epochOf[index] == epoch ? levelOf[index] : 0;
+    }
+
+    void setLevel(size_t index, int value)
+    {
+        if (index >= levelOf.size())
+        {
+            levelOf.resize(std::max(index + 1, 2 * levelOf.size()));
+            epochOf.resize(levelOf.size());
+        }
+        levelOf[index] = value;
+        epochOf[index] = epoch;
+    }
+
+    // L'élu quitte le processeur ; tranche entière consommée : descente d'un niveau
+    void release(size_t index)
+    {
+        if (remainingAtPop - table->remainingTime[index] >= slice)
+        {
+            setLevel(index, std::min<int>(level(index) + 1, queues.size() - 1));
+        }
+        popped = none;
+    }
+
+    // Niveau non vide le plus prioritaire
+    size_t firstLevel() const
+    {
+        size_t l = 0;
+        while (queues[l].empty())
+            l++;
+        return l;
+    }
+
+    void boost()
+    {
+        epoch++;
+        for (size_t l = 1; l < queues.size(); ++l)
+        {
+            while (!queues[l].empty())
+            {
+                queues[0].push_back(queues[l].front());
+                queues[l].pop_front();
+            }
+        }
+    }
+
+public:
+    // Quantum du niveau l : quantum × 2^l, borné à INT_MAX
+    MlfqPolicy(int levels, int quantum, int boost)
+        : queues(std::max(1, levels)), boostInterval(boost)
+    {
+        for (size_t l = 0; l < queues.size(); ++l)
+        {
+            int64_t levelQuantum = int64_t(std::max(1, quantum)) << std::min<size_t>(l, 20);
+            quantums.push_back(static_cast<int>(std::min<int64_t>(levelQuantum, INT_MAX)));
+        }
+    }
+
+    void attach(ProcessTable &t) override
+    {
+        table = &t;
+        for (auto &queue : queues)
+            queue.clear();
+        levelOf.assign(std::max(t.size(), t.pid.capacity()), 0);
+        epochOf.assign(levelOf.size(), 0);
+        epoch = 1;
+        nextBoost = boostInterval;
+        popped = none;
+    }
+
+    void push(size_t index) override
+    {
+        if (table->responseTime[index] == -1)
+        {
+            setLevel(index, 0);
+        }
+        else if (index == popped)
+        {
+            release(index);
+        }
+        queues[level(index)].push_back(index);
+    }
+
+    // Un processus qui rend la main avant la fin de sa tranche garde son niveau
+    void block(size_t index) override
+    {
+        if (index == popped)
+            release(index);
+    }
+
+    size_t pop() override
+    {
+        size_t l = firstLevel();
+        popped = queues[l].front();
+        queues[l].pop_front();
+        remainingAtPop = table->remainingTime[popped];
+        slice = quantums[l];
+        return popped;
+    }
+
+    size_t steal() override
+    {
+        size_t l = firstLevel();
+        size_t index = queues[l].front();
+        queues[l].pop_front();
+        return index;
+    }
+
+    bool empty() const override
+    {
+        for (const auto &queue : queues)
+        {
+            if (!queue.empty())
+                return false;
+        }
+        return true;
+    }
+
+    void advance(int currentTime) override
+    {
+        if (boostInterval > 0 && currentTime >= nextBoost)
+        {
+            boost();
+            nextBoost += ((currentTime - nextBoost) / boostInterval + 1) * int64_t(boostInterval);
+        }
+    }
+
+    bool preempts(size_t arrived, size_t running) const override
+    {
+        int arrivedLevel = table->responseTime[arrived] == -1 ? 0 : level(arrived);
+        return arrivedLevel < level(running);
+    }
+
+    int timeSlice(int remainingTime) const override
+    {
+        return std::min(slice, remainingTime);
+    }
+};
+
+// Partage équitable à la manière de CFS : le prêt de plus petit temps
+// virtuel passe d'abord. Le temps virtuel avance du temps exécuté divisé par
+// le poids, qui décroît de 25 % par point de priorité (la plus petite valeur
+// est la plus prioritaire). Un arrivant part du plus petit temps virtuel déjà
+// élu et préempte l'élu s'il a sur lui plus de minGranularity d'avance. Les
+// tranches partagent targetLatency entre les prêts, sans descendre sous
+// minGranularity.
+class FairSharePolicy : public SchedulingPolicy
+{
+private:
+    static constexpr size_t none = static_cast<size_t>(-1);
+    static constexpr int64_t nice0Weight = 1024;
+    static constexpr int64_t scale = int64_t(1) << 20; // temps virtuel d'une unité de temps au poids 1
+
+    struct ByVruntime
+    {
+        const FairSharePolicy *policy = nullptr;
+
+        bool operator()(size_t a, size_t b) const
+        {
+            const ProcessTable &table = *policy->table;
+            if (policy->vruntime[a] != policy->vruntime[b])
+                return policy->vruntime[a] < policy->vruntime[b];
+            if (table.arrivalTime[a] != table.arrivalTime[b])
+                return table.arrivalTime[a] < table.arrivalTime[b];
+            return table.pid[a] < table.pid[b];
+        }
+    };
+
+    IndexedHeap<ByVruntime> readyQueue;
+    const ProcessTable *table = nullptr;
+    std::vector<int64_t> vruntime;
+    std::vector<int64_t> weight;
+    int64_t minVruntime = 0;
+    int targetLatency;
+    int minGranularity;
+
+    size_t popped = none;
+    int remainingAtPop = 0;
+
+    static int64_t weightOf(int priority)
+    {
+        int nice = std::clamp(priority, -20, 19);
+        return std::max<int64_t>(1, std::llround(nice0Weight * std::pow(1.25, -nice)));
+    }
+
+    // Temps virtuel de l'élu, compte tenu de ce qu'il a exécuté depuis pop()
+    int64_t currentVruntime(size_t index) const
+    {
+        if (index != popped)
+            return vruntime[index];
+        return vruntime[index] + (remainingAtPop - table->remainingTime[index]) * scale / weight[index];
+    }
+
+public:
+    FairSharePolicy(int latency, int granularity)
+        : targetLatency(std::max(1, latency)), minGranularity(std::max(1, granularity)) {}
+
+    void attach(ProcessTable &t) override
+    {
+        table = &t;
+        readyQueue.compare().policy = this;
+        readyQueue.reset(std::max(t.size(), t.pid.capacity()));
+        vruntime.assign(std::max(t.size(), t.pid.capacity()), 0);
+        weight.assign(vruntime.size(), 0); // 0 : pas encore vu par cette file
+        minVruntime = 0;
+        popped = none;
+    }
+
+    void push(size_t index) override
+    {
+        if (index >= vruntime.size())
+        {
+            vruntime.resize(std::max(index + 1, 2 * vruntime.size()));
+            weight.resize(vruntime.size(), 0);
+        }
+        if (table->responseTime[index] == -1)
+        {
+            weight[index] = weightOf(table->priority[index]);
+            vruntime[index] = minVruntime;
+        }
+        else if (index == popped)
+        {
+            vruntime[index] = currentVruntime(index);
+            popped = none;
+        }
+        else
+        {
+            // Réveillé ou venu d'une autre file (vol entre processeurs) : pas d'avance sur les présents
+            if (weight[index] == 0)
+                weight[index] = weightOf(table->priority[index]);
+            vruntime[index] = std::max(vruntime[index], minVruntime);
+        }
+        readyQueue.push(index);
+    }
+
+    // Le dormeur garde son temps virtuel et repart, au réveil, au moins du plus petit
+    void block(size_t index) override
+    {
+        if (index == popped)
+        {
+            vruntime[index] = currentVruntime(index);
+            popped = none;
+        }
+    }
+
+    size_t pop() override
+    {
+        popped = readyQueue.pop();
+        remainingAtPop = table->remainingTime[popped];
+        minVruntime = std::max(minVruntime, vruntime[popped]);
+        return popped;
+    }
+
+    // Le volé n'est pas élu ici : ni l'élu en cours ni minVruntime ne changent
+    size_t steal() override
+    {
+        return readyQueue.pop();
+    }
+
+    bool empty() const override
+    {
+        return readyQueue.empty();
+    }
+
+    bool preempts(size_t arrived, size_t running) const override
+    {
+        // Comme push() : un processus déjà élu repart au moins de minVruntime
+        int64_t arrivedVruntime = table->responseTime[arrived] == -1
+                                      ? minVruntime
+                                      : std::max<int64_t>(vruntime[arrived], minVruntime);
+        return currentVruntime(running) - arrivedVruntime > minGranularity * scale / nice0Weight;
+    }
+
+    int timeSlice(int remainingTime) const override
+    {
+        int share = targetLatency / static_cast<int>(readyQueue.size() + 1);
+        return std::min(remainingTime, std::max(minGranularity, share));
+    }
+};
+
+// Paramètres des politiques ; chacune ne lit que les siens
+struct PolicyOptions
+{
+    int quantum = 0;        // tourniquet ; premier niveau de MLFQ (2 si non renseigné)
+    int levels = 3;         // MLFQ
+    int boostInterval = 0;  // MLFQ : remontée générale périodique, 0 pour aucune
+    int targetLatency = 24; // CFS
+    int minGranularity = 3; // CFS
+
+    bool operator==(const PolicyOptions &other) const
+    {
+        return quantum == other.quantum && levels == other.levels && boostInterval == other.boostInterval &&
+               targetLatency == other.targetLatency && minGranularity == other.minGranularity;
+    }
+};
+
+// Politique enregistrée : nom en ligne de commande, libellé de l'interface
+// graphique et fabrique
+struct PolicyEntry
+{
+    std::string name;
+    std::string label;
+    bool usesQuantum;
+    std::function<std::unique_ptr<SchedulingPolicy>(const PolicyOptions &)> make;
+};
+
+// Registre des politiques, dans l'ordre d'affichage ; registerPolicy() en
+// ajoute une sans toucher aux interfaces qui le parcourent
+inline std::vector<PolicyEntry> &policyRegistry()
+{
+    static std::vector<PolicyEntry> registry = {
+        {"fcfs", "FIFO", false, [](const PolicyOptions &)
+         { return std::make_unique<FifoPolicy>(); }},
+        {"priority", "Priorité avec préemption", false, [](const PolicyOptions &)
+         { return std::make_unique<PriorityPolicy>(); }},
+        {"rr", "Tourniquet", true, [](const PolicyOptions &options)
+         { return std::make_unique<RoundRobinPolicy>(options.quantum); }},
+        {"sjf", "SJFPreemptive", false, [](const PolicyOptions &)
+         { return std::make_unique<SJFPolicy>(); }},
+        {"mlfq", "Files multiniveaux (MLFQ)", true, [](const PolicyOptions &options)
+         { return std::make_unique<MlfqPolicy>(options.levels, options.quantum > 0 ? options.quantum : 2,
+                                               options.boostInterval); }},
+        {"cfs", "Partage équitable (CFS)", false, [](const PolicyOptions &options)
+         { return std::make_unique<FairSharePolicy>(options.targetLatency, options.minGranularity); }},
+    };
+    return registry;
+}
+
+inline void registerPolicy(PolicyEntry entry)
+{
+    policyRegistry().push_back(std::move(entry));
+}
+
+// Entrée du registre pour un nom ("fifo" vaut "fcfs"), nullptr si inconnu
+inline const PolicyEntry *findPolicy(const std::string &name)
+{
+    for (const auto &entry : policyRegistry())
+    {
+        if (entry.name == name || (name == "fifo" && entry.name == "fcfs"))
+            return &entry;
+    }
+    return nullptr;
+}
+
+// Noms enregistrés, séparés par des virgules (messages d'aide)
+inline std::string policyNames()
+{
+    std::string names;
+    for (const auto &entry : policyRegistry())
+    {
+        names += (names.empty() ? "" : ", ") + entry.name;
+    }
+    return names;
+}
+
+// Politique correspondant à un nom de la ligne de commande, nullptr si le nom est inconnu
+inline std::unique_ptr<SchedulingPolicy> makePolicy(const std::string &name, const PolicyOptions &options)
+{
+    const PolicyEntry *entry = findPolicy(name);
+    return entry != nullptr ? entry->make(options) : nullptr;
+}
+
+inline std::unique_ptr<SchedulingPolicy> makePolicy(const std::string &name, int quantum)
+{
+    PolicyOptions options;
+    options.quantum = quantum;
+    return makePolicy(name, options);
+}
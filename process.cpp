@@ -1,311 +1,116 @@
+// Interface graphique GTK de l'ordonnanceur.
+// Compilation : g++ -O2 -std=c++17 -pthread process.cpp -o process $(pkg-config --cflags --libs gtk+-3.0)
 #include <iostream>
 #include <vector>
-#include <queue>
 #include <algorithm>
+#include <cmath>
+#include <memory>
 #include <string>
 #include <sstream>
+#include <thread>
 #include <gtk/gtk.h>
 
-class Process
+#include "cache.h"
+#include "engine.h"
+#include "gantt.h"
+#include "policies.h"
+#include "process.h"
+#include "process_table.h"
+#include "results.h"
+#include "results_model.h"
+#include "timeline.h"
+
+// Simulation en cours sur un fil de travail : elle remplit ses propres
+// tables, échangées avec celles de l'interface une fois terminée
+struct SimulationJob
 {
-public:
-    int pid;
-    std::string name;
-    int arrivalTime;
-    int burstTime;
-    int priority;
-    int remainingTime;
-    int waitingTime;
-    int turnaroundTime;
-    int responseTime;
-
-    Process(int p, std::string n, int at, int bt, int pr = 0)
-        : pid(p), name(n), arrivalTime(at), burstTime(bt),
-          priority(pr), remainingTime(bt), waitingTime(0),
-          turnaroundTime(0), responseTime(-1) {}
+    ProcessTable processes;
+    Timeline timeline;
+    Metrics metrics; // relevées pour le cache
+    GanttIndex gantt;
+    std::unique_ptr<SimulationEngine> engine;
+    uint64_t cacheKey = 0;
+    SimulationControl control;
+    bool cancelled = false;
+    std::thread thread;
 };
 
 class Scheduler
 {
 private:
-    std::vector<Process> processes;
+    ProcessTable processes;
+    Timeline timeline;
     GtkWidget *entryProcesses;
     GtkWidget *entryArrivals;
     GtkWidget *entryDurations;
     GtkWidget *entryPriorities;
-    GtkWidget *fifoRadio;
-    GtkWidget *priorityRadio;
-    GtkWidget *roundRobinRadio;
-    GtkWidget *sjfpreemptiveRadio;
+    std::vector<GtkWidget *> policyRadios; // un bouton par politique du registre, dans son ordre
     GtkWidget *drawingArea;
+    GtkAdjustment *timeAdjustment; // en unités de temps
+    GtkAdjustment *rowAdjustment;  // en pixels
     GtkWidget *treeView;
     GtkWidget *entryQuantum;
+    GtkWidget *btnSchedule;
+    GtkWidget *btnCancel;
+    GtkWidget *progressBar;
+
+    GtkTreeModel *resultsModel;
 
-    GtkListStore *listStore;
+    std::unique_ptr<SimulationJob> job; // nul hors simulation
+    guint progressTimer = 0;
+    ResultCache cache; // lu et écrit par le fil de travail
 
     int quantum = 0;
 
-public:
-    void addProcess(Process p)
-    {
-        processes.push_back(p);
-    }
+    // Diagramme de Gantt
+    static constexpr int rowHeight = 20; // Hauteur de chaque rangée
+    static constexpr int xOffset = 70;   // Décalage horizontal (pour les noms)
+    static constexpr int yOffset = 50;   // Décalage vertical (pour les temps)
+    GanttIndex gantt;
+    double timeScale = 30;                // Pixels par unité de temps
+    cairo_surface_t *gridCache = nullptr; // Lignes de la grille, réutilisées tant que la taille et le zoom ne changent pas
+    int gridCacheWidth = 0;
+    int gridCacheHeight = 0;
+    double gridCacheScale = 0;
 
-    void calculateWaitingAndTurnaround(Process &process, int startTime, int endTime)
-    {
-        process.waitingTime = startTime - process.arrivalTime;
-        process.turnaroundTime = endTime - process.arrivalTime;
-    }
-
-    int getLastProcessId() const
+public:
+    ~Scheduler()
     {
-        if (processes.empty())
+        if (job)
         {
-            return 0;
+            job->control.cancelled = true;
+            job->thread.join();
         }
-        return processes.back().pid;
-    }
-
-    void clearProcesses()
-    {
-        processes.clear();
-        processes.shrink_to_fit();
-    }
-
-    void FCFS()
-    {
-        std::sort(processes.begin(), processes.end(),
-                  [](const Process &a, const Process &b)
-                  {
-                      return a.arrivalTime < b.arrivalTime;
-                  });
-
-        int currentTime = 0;
-        for (auto &process : processes)
+        if (gridCache != nullptr)
         {
-            if (currentTime < process.arrivalTime)
-            {
-                currentTime = process.arrivalTime;
-            }
-
-            int startTime = currentTime;
-            currentTime += process.burstTime;
-            calculateWaitingAndTurnaround(process, startTime, currentTime);
+            cairo_surface_destroy(gridCache);
         }
     }
 
-    void RoundRobin(int quantum)
+    void addProcess(const Process &p)
     {
-        std::queue<Process *> readyQueue;
-        int currentTime = 0;
-        size_t i = 0;
-
-        std::sort(processes.begin(), processes.end(),
-                  [](const Process &a, const Process &b)
-                  {
-                      return a.arrivalTime < b.arrivalTime;
-                  });
-
-        std::vector<bool> firstResponse(processes.size(), true);
-
-        while (i < processes.size() || !readyQueue.empty())
-        {
-            while (i < processes.size() && processes[i].arrivalTime <= currentTime)
-            {
-                readyQueue.push(&processes[i]);
-                i++;
-            }
-
-            if (!readyQueue.empty())
-            {
-                Process *currentProcess = readyQueue.front();
-                readyQueue.pop();
-
-                if (firstResponse[currentProcess->pid - 1])
-                {
-                    currentProcess->responseTime = currentTime - currentProcess->arrivalTime;
-                    firstResponse[currentProcess->pid - 1] = false;
-                }
-
-                int executionTime = std::min(quantum, currentProcess->remainingTime);
-                currentTime += executionTime;
-                currentProcess->remainingTime -= executionTime;
-
-                while (i < processes.size() && processes[i].arrivalTime <= currentTime)
-                {
-                    readyQueue.push(&processes[i]);
-                    i++;
-                }
-
-                if (currentProcess->remainingTime > 0)
-                {
-                    readyQueue.push(currentProcess);
-                }
-                else
-                {
-                    calculateWaitingAndTurnaround(*currentProcess,
-                                                  currentTime - currentProcess->burstTime,
-                                                  currentTime);
-                }
-            }
-            else
-            {
-                currentTime++;
-            }
-        }
-    }
-
-    void PriorityScheduling()
-    {
-        std::queue<Process *> readyQueue;
-
-        int currentTime = 0;
-        size_t i = 0;
-
-        while (i < processes.size() || !readyQueue.empty())
-        {
-            while (i < processes.size() && processes[i].arrivalTime <= currentTime)
-            {
-                readyQueue.push(&processes[i]);
-                i++;
-            }
-
-            if (!readyQueue.empty())
-            {
-                Process *currentProcess = readyQueue.front();
-                readyQueue.pop();
-
-                if (currentProcess->responseTime == -1)
-                {
-                    currentProcess->responseTime = currentTime - currentProcess->arrivalTime;
-                }
-
-                currentProcess->remainingTime = 0;
-                currentTime += currentProcess->burstTime;
-
-                while (i < processes.size() && processes[i].arrivalTime <= currentTime)
-                {
-                    readyQueue.push(&processes[i]);
-                    i++;
-                }
-
-                trier(readyQueue, 1);
-
-                calculateWaitingAndTurnaround(*currentProcess,
-                                              currentTime - currentProcess->burstTime,
-                                              currentTime);
-            }
-            else
-            {
-                currentTime++;
-            }
-        }
+        processes.add(p);
     }
 
-    void trier(std::queue<Process *> &q, int type)
+    int getLastProcessId() const
     {
-        std::vector<Process *> processes;
-
-        // Extraire les éléments de la queue dans un vecteur
-        while (!q.empty())
-        {
-            processes.push_back(q.front());
-            q.pop();
-        }
-
-        // Trier les éléments dans le vecteur
-        if (type == 0)
-        {
-            std::sort(processes.begin(), processes.end(),
-                      [](const Process *a, const Process *b)
-                      {
-                          if (a->burstTime == b->burstTime)
-                          {
-                              return a->arrivalTime < b->arrivalTime;
-                          }
-                          return a->burstTime < b->burstTime;
-                      });
-        }
-        else
-        {
-            std::sort(processes.begin(), processes.end(),
-                      [](const Process *a, const Process *b)
-                      {
-                          if (a->burstTime == b->burstTime)
-                          {
-                              return a->priority < b->priority;
-                          }
-                          return a->priority < b->priority;
-                      });
-        }
-
-        // Réinsérer les éléments triés dans la queue
-        for (const auto &process : processes)
-        {
-            q.push(process);
-        }
+        return processes.lastPid();
     }
 
-    void SJFPreemptive()
+    // Politique correspondant au bouton radio sélectionné
+    const PolicyEntry &selectedPolicy() const
     {
-        std::queue<Process *> readyQueue;
-
-        int currentTime = 0;
-        size_t i = 0;
-
-        while (i < processes.size() || !readyQueue.empty())
+        for (size_t i = 0; i < policyRadios.size(); ++i)
         {
-            while (i < processes.size() && processes[i].arrivalTime <= currentTime)
-            {
-                readyQueue.push(&processes[i]);
-                i++;
-            }
-
-            if (!readyQueue.empty())
-            {
-                Process *currentProcess = readyQueue.front();
-                readyQueue.pop();
-
-                if (currentProcess->responseTime == -1)
-                {
-                    currentProcess->responseTime = currentTime - currentProcess->arrivalTime;
-                }
-
-                currentProcess->remainingTime = 0;
-                currentTime += currentProcess->burstTime;
-
-                while (i < processes.size() && processes[i].arrivalTime <= currentTime)
-                {
-                    readyQueue.push(&processes[i]);
-                    i++;
-                }
-
-                trier(readyQueue, 0);
-
-                calculateWaitingAndTurnaround(*currentProcess,
-                                              currentTime - currentProcess->burstTime,
-                                              currentTime);
-            }
-            else
+            if (gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(policyRadios[i])))
             {
-                currentTime++;
+                return policyRegistry()[i];
             }
         }
+        return policyRegistry().front();
     }
 
-    void displayResults()
-    {
-        std::cout << "PID\tName\t\tArrival\t\tBurst\t\tPriority\t\tWaiting\t\tTurnaround\tResponse\n";
-        for (const auto &process : processes)
-        {
-            std::cout << process.pid << "\t" << process.name << "\t\t" << process.arrivalTime << "\t\t"
-                      << process.burstTime << "\t\t" << process.priority << "\t\t"
-                      << process.waitingTime << "\t\t" << process.turnaroundTime << "\t\t"
-                      << process.responseTime << "\n";
-        }
-    }
-
-    void getInputValues()
+    void getInputValues(ProcessTable &target)
     {
         const char *processesText = gtk_entry_get_text(GTK_ENTRY(entryProcesses));
         const char *arrivalsText = gtk_entry_get_text(GTK_ENTRY(entryArrivals));
@@ -324,41 +129,112 @@ public:
         std::stringstream priorityStream(priorities);
         std::string arrival, burst, priority;
 
-        int count = getLastProcessId() + 1;
+        int count = target.lastPid() + 1;
 
         while (std::getline(arrivalStream, arrival, ',') &&
                std::getline(burstStream, burst, ',') &&
                std::getline(priorityStream, priority, ','))
         {
-            addProcess(Process(count++, "Processus " + std::to_string(count),
-                               std::stoi(arrival), std::stoi(burst), std::stoi(priority)));
+            // Nom par défaut "Processus <pid>", généré à l'affichage
+            target.add(count++, std::stoi(arrival), std::stoi(burst), std::stoi(priority));
         }
     }
 
+    // Lance la simulation sur un fil de travail : la boucle GTK continue de
+    // répondre, l'avancement est relevé périodiquement et le résultat revient
+    // par onSimulationFinished, appelée depuis la boucle principale
     void showAlertWithValues()
     {
-        getInputValues();
-
-        if (gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(fifoRadio)))
-        {
-            FCFS();
-        }
-        else if (gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(roundRobinRadio)))
+        if (job)
         {
-            RoundRobin(quantum);
+            return; // Une simulation à la fois
         }
-        else if (gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(sjfpreemptiveRadio)))
+
+        job = std::make_unique<SimulationJob>();
+        getInputValues(job->processes); // Chaque ordonnancement repart des seules valeurs saisies
+        PolicyOptions options;
+        options.quantum = quantum;
+        const std::string &policyName = selectedPolicy().name;
+        job->engine = makeEngine(policyName, job->processes, options, &job->timeline);
+        job->engine->setMetrics(&job->metrics);
+        job->processes.sortByArrival(); // comme le fera run(), avant d'en calculer la clé
+        job->cacheKey = ResultCache::key(job->processes, policyName, options);
+
+        gtk_widget_set_sensitive(btnSchedule, FALSE);
+        gtk_widget_set_sensitive(btnCancel, TRUE);
+        gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(progressBar), 0);
+        gtk_progress_bar_set_text(GTK_PROGRESS_BAR(progressBar), "Simulation…");
+        progressTimer = g_timeout_add(100, onProgressTick, this);
+
+        SimulationJob *work = job.get();
+        job->thread = std::thread([this, work]()
+                                  {
+                                      // Une simulation déjà faite est relue du cache
+                                      if (!cache.load(work->cacheKey, work->processes, work->timeline, work->metrics))
+                                      {
+                                          work->engine->setControl(&work->control);
+                                          work->engine->run();
+                                          work->cancelled = work->engine->cancelled();
+                                          if (!work->cancelled)
+                                          {
+                                              cache.store(work->cacheKey, work->processes, work->timeline, work->metrics);
+                                          }
+                                      }
+                                      if (!work->cancelled)
+                                      {
+                                          work->gantt.build(work->processes, work->timeline);
+                                          writeResults(std::cout, work->processes, work->timeline);
+                                      }
+                                      g_idle_add(onSimulationFinished, this);
+                                  });
+    }
+
+    // Boucle principale : récupère les résultats du fil de travail
+    static gboolean onSimulationFinished(gpointer data)
+    {
+        Scheduler *scheduler = static_cast<Scheduler *>(data);
+        std::unique_ptr<SimulationJob> job = std::move(scheduler->job);
+        job->thread.join();
+        g_source_remove(scheduler->progressTimer);
+        scheduler->progressTimer = 0;
+
+        GtkProgressBar *progress = GTK_PROGRESS_BAR(scheduler->progressBar);
+        if (job->cancelled)
         {
-            SJFPreemptive();
+            gtk_progress_bar_set_text(progress, "Annulé");
         }
         else
         {
-            PriorityScheduling();
+            std::swap(scheduler->processes, job->processes);
+            std::swap(scheduler->timeline, job->timeline);
+            std::swap(scheduler->gantt, job->gantt);
+            gtk_adjustment_set_value(scheduler->timeAdjustment, 0);
+            gtk_adjustment_set_value(scheduler->rowAdjustment, 0);
+            scheduler->updateTreeView();
+            scheduler->drawGrid();
+            gtk_progress_bar_set_fraction(progress, 1);
+            gtk_progress_bar_set_text(progress, "Terminé");
         }
 
-        displayResults();
-        updateTreeView();
-        drawGrid();
+        gtk_widget_set_sensitive(scheduler->btnSchedule, TRUE);
+        gtk_widget_set_sensitive(scheduler->btnCancel, FALSE);
+        return G_SOURCE_REMOVE;
+    }
+
+    // Avancement : processus terminés sur le total, et événements traités
+    static gboolean onProgressTick(gpointer data)
+    {
+        Scheduler *scheduler = static_cast<Scheduler *>(data);
+        const SimulationJob &job = *scheduler->job;
+        uint64_t completed = job.control.completed.load(std::memory_order_relaxed);
+        uint64_t events = job.control.events.load(std::memory_order_relaxed);
+
+        std::string text = std::to_string(completed) + " / " + std::to_string(job.processes.size()) +
+                           " processus, " + std::to_string(events) + " événements";
+        gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(scheduler->progressBar),
+                                      job.processes.empty() ? 0 : static_cast<double>(completed) / job.processes.size());
+        gtk_progress_bar_set_text(GTK_PROGRESS_BAR(scheduler->progressBar), text.c_str());
+        return G_SOURCE_CONTINUE;
     }
 
     void drawGrid()
@@ -366,82 +242,208 @@ public:
         gtk_widget_queue_draw(drawingArea);
     }
 
-    static gboolean on_draw(GtkWidget *widget, cairo_t *cr, gpointer data)
+    // Met à jour les plages de défilement selon la taille de la zone et le zoom
+    void updateGanttRange(int width, int height)
     {
-        Scheduler *scheduler = static_cast<Scheduler *>(data); // Convertir les données
+        double visibleTime = std::max(1, width - xOffset) / timeScale;
+        double span = std::max<double>(gantt.horizon(), visibleTime);
+        double step = ganttTickStep(30 / timeScale);
+        gtk_adjustment_configure(timeAdjustment, gtk_adjustment_get_value(timeAdjustment), 0, span,
+                                 step, visibleTime * 0.9, visibleTime);
+
+        double visibleRows = std::max(1, height - yOffset);
+        double rowsHeight = std::max<double>(gantt.rows() * rowHeight, visibleRows);
+        gtk_adjustment_configure(rowAdjustment, gtk_adjustment_get_value(rowAdjustment), 0, rowsHeight,
+                                 rowHeight, visibleRows * 0.9, visibleRows);
+    }
 
-        // Dimensions de la grille
-        const int cellWidth = 30; // Largeur de chaque cellule
-        const int rowHeight = 20; // Hauteur de chaque rangée
-        const int xOffset = 70;   // Décalage horizontal (pour les temps)
-        const int yOffset = 50;   // Décalage vertical (pour commencer à dessiner)
-        const int quantum = 7;    // Quantum de 4 unités de temps
+    // Lignes de la grille sur une surface transparente couvrant la zone visible
+    // plus une période dans chaque direction : le défilement ne fait que décaler
+    // la surface, elle n'est redessinée que si la taille ou le zoom changent.
+    cairo_surface_t *ganttGridSurface(cairo_t *cr, int width, int height, double tickPixels)
+    {
+        if (gridCache != nullptr && gridCacheWidth == width && gridCacheHeight == height &&
+            gridCacheScale == timeScale)
+        {
+            return gridCache;
+        }
+        if (gridCache != nullptr)
+        {
+            cairo_surface_destroy(gridCache);
+        }
 
-        // Dessiner les en-têtes des temps
-        cairo_set_source_rgb(cr, 0, 0, 0); // Texte en noir
-        for (int t = 0; t <= 50; ++t)
-        { // Ajustez 50 en fonction de la durée maximale
-            std::string timeLabel = std::to_string(t);
-            cairo_move_to(cr, xOffset + t * cellWidth + cellWidth / 4, yOffset - 10);
-            cairo_show_text(cr, timeLabel.c_str());
+        int surfaceWidth = width + static_cast<int>(std::ceil(tickPixels)) + 1;
+        int surfaceHeight = height + rowHeight + 1;
+        gridCache = cairo_surface_create_similar(cairo_get_target(cr), CAIRO_CONTENT_COLOR_ALPHA,
+                                                 surfaceWidth, surfaceHeight);
+        gridCacheWidth = width;
+        gridCacheHeight = height;
+        gridCacheScale = timeScale;
+
+        cairo_t *grid = cairo_create(gridCache);
+        cairo_set_source_rgb(grid, 0, 0, 0); // Couleur noire pour les lignes
+        cairo_set_line_width(grid, 1);
+        for (double x = 0; x <= surfaceWidth; x += tickPixels)
+        {
+            cairo_move_to(grid, std::floor(x) + 0.5, 0);
+            cairo_line_to(grid, std::floor(x) + 0.5, surfaceHeight);
+        }
+        for (int y = 0; y <= surfaceHeight; y += rowHeight)
+        {
+            cairo_move_to(grid, 0, y + 0.5);
+            cairo_line_to(grid, surfaceWidth, y + 0.5);
         }
+        cairo_stroke(grid);
+        cairo_destroy(grid);
+        return gridCache;
+    }
 
-        // Dessiner les grilles et les processus
-        int row = 0; // Rangée initiale
-        for (const auto &process : scheduler->processes)
+    static gboolean on_draw(GtkWidget *widget, cairo_t *cr, gpointer data)
+    {
+        Scheduler *scheduler = static_cast<Scheduler *>(data); // Convertir les données
+        const ProcessTable &processes = scheduler->processes;
+        const GanttIndex &gantt = scheduler->gantt;
+
+        int width = gtk_widget_get_allocated_width(widget);
+        int height = gtk_widget_get_allocated_height(widget);
+        scheduler->updateGanttRange(width, height);
+
+        // Fenêtre visible : [viewStart, viewEnd) en temps, rangées [firstRow, lastRow)
+        double scale = scheduler->timeScale;
+        double viewStart = gtk_adjustment_get_value(scheduler->timeAdjustment);
+        double viewEnd = viewStart + (width - xOffset) / scale;
+        double scrollY = gtk_adjustment_get_value(scheduler->rowAdjustment);
+        size_t firstRow = static_cast<size_t>(scrollY / rowHeight);
+        size_t lastRow = std::min(gantt.rows(), static_cast<size_t>((scrollY + height - yOffset) / rowHeight) + 1);
+        double gridHeight = std::min<double>(height - yOffset, gantt.rows() * rowHeight - scrollY);
+        double tickStep = ganttTickStep(30 / scale);
+
+        auto xOf = [&](double t)
+        {
+            return xOffset + (t - viewStart) * scale;
+        };
+        auto yOf = [&](size_t row)
         {
-            int startTime = process.arrivalTime + process.waitingTime; // Correction ici
-            int endTime = startTime + process.burstTime;
+            return yOffset + row * rowHeight - scrollY;
+        };
 
-            // Dessiner la barre de progression en segments de 4 cases
-            for (int t = process.arrivalTime; t < endTime; t += quantum)
+        cairo_save(cr);
+        cairo_rectangle(cr, xOffset, yOffset, width - xOffset, std::max(0.0, gridHeight));
+        cairo_clip(cr);
+
+        // Présence dans le système, de l'arrivée à la fin d'exécution : un
+        // rectangle par rangée visible, un seul remplissage pour toutes
+        cairo_set_source_rgb(cr, 0.0, 1.0, 1.0); // Cyan
+        for (size_t row = firstRow; row < lastRow; ++row)
+        {
+            double start = std::max<double>(processes.arrivalTime[row], viewStart);
+            double end = std::min<double>(processes.arrivalTime[row] + processes.turnaroundTime[row], viewEnd);
+            if (start < end)
             {
-                int segmentEnd = std::min(t + quantum, endTime);
-                for (int i = t; i < segmentEnd; ++i)
-                {
-                    // Couleur de la barre de progression
-                    if (i < startTime)
-                    {
-                        cairo_set_source_rgb(cr, 0.0, 1.0, 1.0); // Bleu
-                    }
-                    else
-                    {
-                        cairo_set_source_rgb(cr, 0.0, 0.0, 1.0); // Bleu
-                    }
-                    cairo_rectangle(cr, xOffset + i * cellWidth, yOffset + row * rowHeight, cellWidth, rowHeight);
-                    cairo_fill(cr);
-                }
+                cairo_rectangle(cr, xOf(start), yOf(row), (end - start) * scale, rowHeight);
             }
+        }
+        cairo_fill(cr);
 
-            // Dessiner les lignes de la grille
-            cairo_set_source_rgb(cr, 0, 0, 0); // Couleur noire pour les lignes
-            cairo_set_line_width(cr, 1);
-            for (int t = 0; t <= 50; ++t)
-            { // Ajustez 50 pour le temps maximal
-                cairo_move_to(cr, xOffset + t * cellWidth, yOffset);
-                cairo_line_to(cr, xOffset + t * cellWidth, yOffset + (row + 1) * rowHeight);
-            }
-            cairo_move_to(cr, xOffset, yOffset + (row + 1) * rowHeight);
-            cairo_line_to(cr, xOffset + 50 * cellWidth, yOffset + (row + 1) * rowHeight); // Ligne horizontale
-            cairo_stroke(cr);                                                             // Dessiner les lignes
+        // Segments exécutés qui coupent la fenêtre, fusionnés au pixel près
+        cairo_set_source_rgb(cr, 0.0, 0.0, 1.0); // Bleu
+        for (size_t row = firstRow; row < lastRow; ++row)
+        {
+            gantt.forEachRun(row, viewStart, viewEnd, 1 / scale,
+                             [&](int start, int end)
+                             {
+                                 double left = xOf(std::max<double>(start, viewStart - 1));
+                                 double right = xOf(std::min<double>(end, viewEnd + 1));
+                                 cairo_rectangle(cr, left, yOf(row), std::max(1.0, right - left), rowHeight);
+                             });
+        }
+        cairo_fill(cr);
+
+        // Grille en cache, décalée selon le défilement
+        double tickPixels = tickStep * scale;
+        cairo_surface_t *grid = scheduler->ganttGridSurface(cr, width - xOffset, height - yOffset, tickPixels);
+        cairo_set_source_surface(cr, grid, xOffset - std::fmod(viewStart, tickStep) * scale,
+                                 yOffset - std::fmod(scrollY, rowHeight));
+        cairo_paint(cr);
+        cairo_restore(cr);
 
-            // Ajouter le texte du nom du processus
-            cairo_set_source_rgb(cr, 0, 0, 0); // Noir
-            cairo_move_to(cr, 10, yOffset + row * rowHeight + rowHeight / 2);
-            cairo_show_text(cr, process.name.c_str()); // Afficher le nom du processus
+        // Dessiner les en-têtes des temps visibles
+        cairo_set_source_rgb(cr, 0, 0, 0); // Texte en noir
+        for (double t = std::ceil(viewStart / tickStep) * tickStep; t < viewEnd; t += tickStep)
+        {
+            std::string timeLabel = std::to_string(static_cast<long long>(t));
+            cairo_move_to(cr, xOf(t) + 3, yOffset - 10);
+            cairo_show_text(cr, timeLabel.c_str());
+        }
 
-            row++; // Passer à la rangée suivante
+        // Ajouter le nom des processus visibles
+        cairo_save(cr);
+        cairo_rectangle(cr, 0, yOffset, xOffset, height - yOffset);
+        cairo_clip(cr);
+        for (size_t row = firstRow; row < lastRow; ++row)
+        {
+            cairo_move_to(cr, 10, yOf(row) + rowHeight / 2 + 4);
+            cairo_show_text(cr, processes.name(row).c_str()); // Afficher le nom du processus
         }
+        cairo_restore(cr);
 
-        // Dernière ligne horizontale pour fermer la grille
-        cairo_set_source_rgb(cr, 0, 0, 0);
-        cairo_move_to(cr, xOffset, yOffset + row * rowHeight);
-        cairo_line_to(cr, xOffset + 50 * cellWidth, yOffset + row * rowHeight);
-        cairo_stroke(cr); // Dessiner la dernière ligne
+        return FALSE; // Indiquer que le dessin est terminé
+    }
 
-        scheduler->clearProcesses(); // Assurez-vous que cela est nécessaire
-        return FALSE;                // Indiquer que le dessin est terminé
-        return FALSE;
+    static void onGanttScrolled(GtkAdjustment * /*adjustment*/, gpointer data)
+    {
+        Scheduler *scheduler = static_cast<Scheduler *>(data);
+        scheduler->drawGrid();
+    }
+
+    // Molette : défilement vertical (horizontal avec Maj), zoom autour du pointeur avec Ctrl
+    static gboolean onGanttScroll(GtkWidget *widget, GdkEventScroll *event, gpointer data)
+    {
+        Scheduler *scheduler = static_cast<Scheduler *>(data);
+        double dx = 0, dy = 0;
+        switch (event->direction)
+        {
+        case GDK_SCROLL_UP:
+            dy = -1;
+            break;
+        case GDK_SCROLL_DOWN:
+            dy = 1;
+            break;
+        case GDK_SCROLL_LEFT:
+            dx = -1;
+            break;
+        case GDK_SCROLL_RIGHT:
+            dx = 1;
+            break;
+        default:
+            gdk_event_get_scroll_deltas(reinterpret_cast<GdkEvent *>(event), &dx, &dy);
+            break;
+        }
+
+        GtkAdjustment *time = scheduler->timeAdjustment;
+        GtkAdjustment *rows = scheduler->rowAdjustment;
+        if (event->state & GDK_CONTROL_MASK)
+        {
+            int width = gtk_widget_get_allocated_width(widget);
+            double anchor = std::max(0.0, event->x - xOffset);
+            double anchorTime = gtk_adjustment_get_value(time) + anchor / scheduler->timeScale;
+            double fitScale = (width - xOffset) / std::max(1.0, static_cast<double>(scheduler->gantt.horizon()));
+            scheduler->timeScale = std::clamp(scheduler->timeScale * std::pow(1.25, -dy),
+                                              std::min(fitScale, 1.0), 60.0);
+            scheduler->updateGanttRange(width, gtk_widget_get_allocated_height(widget));
+            gtk_adjustment_set_value(time, anchorTime - anchor / scheduler->timeScale);
+        }
+        else if (event->state & GDK_SHIFT_MASK)
+        {
+            gtk_adjustment_set_value(time, gtk_adjustment_get_value(time) + dy * gtk_adjustment_get_page_increment(time) / 3);
+        }
+        else
+        {
+            gtk_adjustment_set_value(time, gtk_adjustment_get_value(time) + dx * gtk_adjustment_get_page_increment(time) / 3);
+            gtk_adjustment_set_value(rows, gtk_adjustment_get_value(rows) + dy * 3 * rowHeight);
+        }
+        scheduler->drawGrid();
+        return TRUE;
     }
 
     void createGUI()
@@ -450,7 +452,7 @@ public:
         GtkWidget *grid;                                                  // Grille pour organiser les widgets
         GtkWidget *typeFrame, *paramsFrame, *buttonsFrame, *resultsFrame; // Cadres pour les sections
         GtkWidget *typeBox, *paramsBox, *buttonsBox, *resultsBox;         // Boîtes pour les sections
-        GtkWidget *btnSchedule, *btnReset;                                // Boutons pour ordonner et réinitialiser
+        GtkWidget *btnReset;                                              // Bouton pour réinitialiser
 
         gtk_init(NULL, NULL); // Initialiser GTK
 
@@ -467,18 +469,15 @@ public:
         typeBox = gtk_box_new(GTK_ORIENTATION_VERTICAL, 5);
         gtk_container_add(GTK_CONTAINER(typeFrame), typeBox);
 
-        // Boutons radio pour les algorithmes
-        fifoRadio = gtk_radio_button_new_with_label(NULL, "FIFO");
-        gtk_box_pack_start(GTK_BOX(typeBox), fifoRadio, FALSE, FALSE, 0);
-
-        priorityRadio = gtk_radio_button_new_with_label_from_widget(GTK_RADIO_BUTTON(fifoRadio), "Priorité avec préemption");
-        gtk_box_pack_start(GTK_BOX(typeBox), priorityRadio, FALSE, FALSE, 0);
-
-        roundRobinRadio = gtk_radio_button_new_with_label_from_widget(GTK_RADIO_BUTTON(fifoRadio), "Tourniquet");
-        gtk_box_pack_start(GTK_BOX(typeBox), roundRobinRadio, FALSE, FALSE, 0);
-
-        sjfpreemptiveRadio = gtk_radio_button_new_with_label_from_widget(GTK_RADIO_BUTTON(fifoRadio), "SJFPreemptive");
-        gtk_box_pack_start(GTK_BOX(typeBox), sjfpreemptiveRadio, FALSE, FALSE, 0);
+        // Boutons radio pour les algorithmes, un par politique enregistrée
+        for (const PolicyEntry &entry : policyRegistry())
+        {
+            GtkWidget *radio = policyRadios.empty()
+                                   ? gtk_radio_button_new_with_label(NULL, entry.label.c_str())
+                                   : gtk_radio_button_new_with_label_from_widget(GTK_RADIO_BUTTON(policyRadios.front()), entry.label.c_str());
+            gtk_box_pack_start(GTK_BOX(typeBox), radio, FALSE, FALSE, 0);
+            policyRadios.push_back(radio);
+        }
 
         gtk_grid_attach(GTK_GRID(grid), typeFrame, 0, 0, 1, 1); // Ajouter le cadre à la grille
 
@@ -518,56 +517,74 @@ public:
         btnSchedule = gtk_button_new_with_label("Ordonner");                           // Bouton pour ordonner
         g_signal_connect(btnSchedule, "clicked", G_CALLBACK(onScheduleClicked), this); // Connecter le signal
 
+        btnCancel = gtk_button_new_with_label("Annuler");                          // Bouton pour interrompre la simulation
+        g_signal_connect(btnCancel, "clicked", G_CALLBACK(onCancelClicked), this); // Connecter le signal
+        gtk_widget_set_sensitive(btnCancel, FALSE);                                // Actif seulement pendant une simulation
+
         btnReset = gtk_button_new_with_label("Réinitialiser");               // Bouton pour réinitialiser
         gtk_box_pack_start(GTK_BOX(buttonsBox), btnSchedule, TRUE, TRUE, 0); // Ajouter le bouton d'ordonnancement
+        gtk_box_pack_start(GTK_BOX(buttonsBox), btnCancel, TRUE, TRUE, 0);   // Ajouter le bouton d'annulation
         gtk_box_pack_start(GTK_BOX(buttonsBox), btnReset, TRUE, TRUE, 0);    // Ajouter le bouton de réinitialisation
 
+        progressBar = gtk_progress_bar_new();                                // Avancement de la simulation
+        gtk_progress_bar_set_show_text(GTK_PROGRESS_BAR(progressBar), TRUE); // Afficher le texte d'avancement
+        gtk_box_pack_start(GTK_BOX(buttonsBox), progressBar, TRUE, TRUE, 0); // Ajouter la barre de progression
+
         gtk_grid_attach(GTK_GRID(grid), buttonsFrame, 0, 1, 2, 1); // Ajouter le cadre des boutons à la grille
 
         // Ajout de la zone de dessin
+        GtkWidget *ganttGrid = gtk_grid_new();                            // Zone de dessin et ses barres de défilement
         drawingArea = gtk_drawing_area_new();                             // Créer la zone de dessin
         gtk_widget_set_hexpand(drawingArea, TRUE);                        // Permet l'expansion horizontale
         gtk_widget_set_vexpand(drawingArea, TRUE);                        // Permet l'expansion verticale
-        gtk_grid_attach(GTK_GRID(grid), drawingArea, 0, 2, 2, 1);         // Ajouter la zone de dessin à la grille
-        g_signal_connect(drawingArea, "draw", G_CALLBACK(on_draw), this); // Connecter le signal de dessin
+        gtk_widget_add_events(drawingArea, GDK_SCROLL_MASK | GDK_SMOOTH_SCROLL_MASK);
+        gtk_grid_attach(GTK_GRID(ganttGrid), drawingArea, 0, 0, 1, 1);
+        g_signal_connect(drawingArea, "draw", G_CALLBACK(on_draw), this);           // Connecter le signal de dessin
+        g_signal_connect(drawingArea, "scroll-event", G_CALLBACK(onGanttScroll), this); // Molette : défilement, Ctrl : zoom
+
+        timeAdjustment = gtk_adjustment_new(0, 0, 1, 1, 1, 1);
+        rowAdjustment = gtk_adjustment_new(0, 0, 1, rowHeight, rowHeight, 1);
+        gtk_grid_attach(GTK_GRID(ganttGrid), gtk_scrollbar_new(GTK_ORIENTATION_VERTICAL, rowAdjustment), 1, 0, 1, 1);
+        gtk_grid_attach(GTK_GRID(ganttGrid), gtk_scrollbar_new(GTK_ORIENTATION_HORIZONTAL, timeAdjustment), 0, 1, 1, 1);
+        g_signal_connect(timeAdjustment, "value-changed", G_CALLBACK(onGanttScrolled), this);
+        g_signal_connect(rowAdjustment, "value-changed", G_CALLBACK(onGanttScrolled), this);
+        gtk_grid_attach(GTK_GRID(grid), ganttGrid, 0, 2, 2, 1); // Ajouter la zone de dessin à la grille
 
         // Ajout du tableau des résultats
         resultsFrame = gtk_frame_new("Résultats");                  // Cadre pour les résultats
         resultsBox = gtk_box_new(GTK_ORIENTATION_VERTICAL, 5);      // Boîte pour les résultats
         gtk_container_add(GTK_CONTAINER(resultsFrame), resultsBox); // Ajouter la boîte au cadre
 
-        // Créer le modèle de liste pour le tableau
-        listStore = gtk_list_store_new(9, G_TYPE_INT, G_TYPE_STRING, G_TYPE_INT, G_TYPE_INT, G_TYPE_INT, G_TYPE_INT, G_TYPE_INT, G_TYPE_INT, G_TYPE_INT); // Modèle de liste avec 9 colonnes
+        // Modèle paresseux lu dans la table des processus : seules les lignes
+        // visibles sont lues, le tri ne permute que des indices
+        resultsModel = resultsModelNew();
+        resultsModelSetTable(resultsModel, &processes);
 
         // Créer le GtkTreeView
-        treeView = gtk_tree_view_new_with_model(GTK_TREE_MODEL(listStore)); // Créer la vue d'arbre avec le modèle
-        g_object_unref(listStore);                                          // Le modèle est maintenant détenu par le treeView
-
-        // Créer les colonnes pour le tableau
-        GtkCellRenderer *renderer = gtk_cell_renderer_text_new();                                               // Créer un renderer pour le texte
-        GtkTreeViewColumn *column = gtk_tree_view_column_new_with_attributes("PID", renderer, "text", 0, NULL); // Colonne pour PID
-        gtk_tree_view_append_column(GTK_TREE_VIEW(treeView), column);                                           // Ajouter la colonne à la vue
-
-        column = gtk_tree_view_column_new_with_attributes("Name", renderer, "text", 1, NULL); // Colonne pour le nom
-        gtk_tree_view_append_column(GTK_TREE_VIEW(treeView), column);                         // Ajouter la colonne à la vue
-
-        column = gtk_tree_view_column_new_with_attributes("Arrival", renderer, "text", 2, NULL); // Colonne pour le temps d'arrivée
-        gtk_tree_view_append_column(GTK_TREE_VIEW(treeView), column);                            // Ajouter la colonne à la vue
-
-        column = gtk_tree_view_column_new_with_attributes("Burst", renderer, "text", 3, NULL); // Colonne pour le temps d'exécution
-        gtk_tree_view_append_column(GTK_TREE_VIEW(treeView), column);                          // Ajouter la colonne à la vue
-
-        column = gtk_tree_view_column_new_with_attributes("Priority", renderer, "text", 4, NULL); // Colonne pour la priorité
-        gtk_tree_view_append_column(GTK_TREE_VIEW(treeView), column);                             // Ajouter la colonne à la vue
-
-        column = gtk_tree_view_column_new_with_attributes("Waiting", renderer, "text", 5, NULL); // Colonne pour le temps d'attente
-        gtk_tree_view_append_column(GTK_TREE_VIEW(treeView), column);                            // Ajouter la colonne à la vue
-
-        column = gtk_tree_view_column_new_with_attributes("Turnaround", renderer, "text", 6, NULL); // Colonne pour le temps de retour
-        gtk_tree_view_append_column(GTK_TREE_VIEW(treeView), column);                               // Ajouter la colonne à la vue
+        treeView = gtk_tree_view_new_with_model(resultsModel); // Créer la vue d'arbre avec le modèle
+        g_object_unref(resultsModel);                          // Le modèle est maintenant détenu par le treeView
+
+        // Créer les colonnes pour le tableau, de largeur fixe : la vue n'a pas
+        // à mesurer toutes les lignes pour se dimensionner
+        static const char *const titles[ResultsColumnCount] = {"PID", "Name", "Arrival", "Burst", "Priority",
+                                                               "Waiting", "Turnaround", "Response"};
+        GtkCellRenderer *renderer = gtk_cell_renderer_text_new(); // Créer un renderer pour le texte
+        for (int i = 0; i < ResultsColumnCount; ++i)
+        {
+            GtkTreeViewColumn *column = gtk_tree_view_column_new_with_attributes(titles[i], renderer, "text", i, NULL);
+            gtk_tree_view_column_set_sizing(column, GTK_TREE_VIEW_COLUMN_FIXED);
+            gtk_tree_view_column_set_fixed_width(column, i == ResultsName ? 140 : 85);
+            gtk_tree_view_column_set_resizable(column, TRUE);
+            gtk_tree_view_column_set_sort_column_id(column, i); // Tri au clic sur l'en-tête
+            gtk_tree_view_append_column(GTK_TREE_VIEW(treeView), column);
+        }
+        gtk_tree_view_set_fixed_height_mode(GTK_TREE_VIEW(treeView), TRUE); // Lignes de hauteur égale, non mesurées
 
-        // Ajouter le GtkTreeView au conteneur
-        gtk_box_pack_start(GTK_BOX(resultsBox), treeView, TRUE, TRUE, 0); // Ajouter la vue d'arbre à la boîte des résultats
+        // Ajouter le GtkTreeView au conteneur, dans une zone défilante
+        GtkWidget *resultsScroll = gtk_scrolled_window_new(NULL, NULL);
+        gtk_scrolled_window_set_min_content_height(GTK_SCROLLED_WINDOW(resultsScroll), 150);
+        gtk_container_add(GTK_CONTAINER(resultsScroll), treeView);
+        gtk_box_pack_start(GTK_BOX(resultsBox), resultsScroll, TRUE, TRUE, 0); // Ajouter la vue d'arbre à la boîte des résultats
 
         // Ajouter le cadre des résultats à la grille
         gtk_grid_attach(GTK_GRID(grid), resultsFrame, 0, 3, 2, 1); // Ajouter le cadre des résultats à la grille
@@ -576,31 +593,31 @@ public:
         gtk_main();                  // Lancer la boucle principale de GTK
     }
 
+    // Rattache le modèle aux nouveaux résultats ; il est détaché le temps du
+    // changement pour que la vue ne reçoive pas un signal par ligne
     void updateTreeView()
     {
-        gtk_list_store_clear(listStore);
-        for (const auto &process : processes)
-        {
-            GtkTreeIter iter;
-            gtk_list_store_append(listStore, &iter);
-            gtk_list_store_set(listStore, &iter,
-                               0, process.pid,
-                               1, process.name.c_str(),
-                               2, process.arrivalTime,
-                               3, process.burstTime,
-                               4, process.priority,
-                               5, process.waitingTime,
-                               6, process.turnaroundTime,
-                               7, process.responseTime,
-                               -1);
-        }
+        g_object_ref(resultsModel);
+        gtk_tree_view_set_model(GTK_TREE_VIEW(treeView), NULL);
+        resultsModelSetTable(resultsModel, &processes);
+        gtk_tree_view_set_model(GTK_TREE_VIEW(treeView), resultsModel);
+        g_object_unref(resultsModel);
     }
 
-    static void onScheduleClicked(GtkWidget *widget, gpointer data)
+    static void onScheduleClicked(GtkWidget * /*widget*/, gpointer data)
     {
         Scheduler *scheduler = static_cast<Scheduler *>(data);
         scheduler->showAlertWithValues();
     }
+
+    static void onCancelClicked(GtkWidget * /*widget*/, gpointer data)
+    {
+        Scheduler *scheduler = static_cast<Scheduler *>(data);
+        if (scheduler->job)
+        {
+            scheduler->job->control.cancelled = true;
+        }
+    }
 };
 int main()
 {
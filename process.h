@@ -0,0 +1,22 @@
+#pragma once
+
+#include <string>
+
+class Process
+{
+public:
+    int pid;
+    std::string name;
+    int arrivalTime;
+    int burstTime;
+    int priority;
+    int remainingTime;
+    int waitingTime;
+    int turnaroundTime;
+    int responseTime;
+
+    Process(int p, std::string n, int at, int bt, int pr = 0)
+        : pid(p), name(n), arrivalTime(at), burstTime(bt),
+          priority(pr), remainingTime(bt), waitingTime(0),
+          turnaroundTime(0), responseTime(-1) {}
+};
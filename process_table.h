@@ -0,0 +1,297 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "process.h"
+
+// Noms de processus stockés une seule fois, désignés par un identifiant
+class NamePool
+{
+private:
+    std::deque<std::string> names; // adresses stables pour les clés de la table
+    std::unordered_map<std::string_view, int32_t> ids;
+
+public:
+    NamePool() = default;
+    NamePool(NamePool &&) = default;
+    NamePool &operator=(NamePool &&) = default;
+
+    // Les clés d'une copie désignent ses propres chaînes, pas celles de l'original
+    NamePool(const NamePool &other)
+    {
+        *this = other;
+    }
+
+    NamePool &operator=(const NamePool &other)
+    {
+        if (this != &other)
+        {
+            clear();
+            for (const auto &name : other.names)
+                intern(name);
+        }
+        return *this;
+    }
+
+    int32_t intern(std::string_view name)
+    {
+        auto found = ids.find(name);
+        if (found != ids.end())
+            return found->second;
+
+        int32_t id = static_cast<int32_t>(names.size());
+        names.emplace_back(name);
+        ids.emplace(names.back(), id);
+        return id;
+    }
+
+    const std::string &operator[](int32_t id) const
+    {
+        return names[id];
+    }
+
+    void clear()
+    {
+        ids.clear();
+        names.clear();
+    }
+};
+
+// Entrée-sortie d'un processus, suivie de sa rafale de calcul suivante
+struct IoBurst
+{
+    int device;  // numéro du périphérique, à partir de 0
+    int ioTime;  // durée de service sur le périphérique
+    int cpuTime; // rafale de calcul au retour
+};
+
+// Table des processus en colonnes : chaque attribut est un tableau contigu,
+// indexé par la position du processus dans la table.
+class ProcessTable
+{
+public:
+    static constexpr int32_t defaultName = -1; // nom déduit du pid
+
+    std::vector<int> pid;
+    std::vector<int> arrivalTime;
+    std::vector<int> burstTime;
+    std::vector<int> priority;
+    std::vector<int> remainingTime;
+    std::vector<int> waitingTime;
+    std::vector<int> turnaroundTime;
+    std::vector<int> responseTime;
+    std::vector<int32_t> nameId;
+    NamePool namePool;
+
+    // Séquences de rafales : un processus alterne calcul et entrées-sorties.
+    // burstTime est alors son temps de calcul total et ses entrées-sorties
+    // sont ioBursts[ioFirst[i]] à ioBursts[ioFirst[i] + ioCount[i] - 1].
+    // Colonnes vides tant qu'aucun processus ne fait d'entrée-sortie.
+    std::vector<uint32_t> ioFirst;
+    std::vector<uint32_t> ioCount;
+    std::vector<IoBurst> ioBursts;
+    int ioDevices = 0; // plus grand numéro de périphérique + 1
+
+    size_t size() const
+    {
+        return pid.size();
+    }
+
+    bool empty() const
+    {
+        return pid.empty();
+    }
+
+    bool hasIo() const
+    {
+        return !ioBursts.empty();
+    }
+
+    int lastPid() const
+    {
+        return pid.empty() ? 0 : pid.back();
+    }
+
+    void reserve(size_t count)
+    {
+        for (auto *column : columns())
+            column->reserve(count);
+        nameId.reserve(count);
+        if (hasIo())
+        {
+            ioFirst.reserve(count);
+            ioCount.reserve(count);
+        }
+    }
+
+    void clear()
+    {
+        for (auto *column : columns())
+            column->clear();
+        nameId.clear();
+        namePool.clear();
+        ioFirst.clear();
+        ioCount.clear();
+        ioBursts.clear();
+        ioDevices = 0;
+    }
+
+    // Un nom vide ne coûte rien : il est généré à l'affichage à partir du pid
+    size_t add(int id, int arrival, int burst, int prio = 0, std::string_view name = {})
+    {
+        pid.push_back(id);
+        arrivalTime.push_back(arrival);
+        burstTime.push_back(burst);
+        priority.push_back(prio);
+        remainingTime.push_back(burst);
+        waitingTime.push_back(0);
+        turnaroundTime.push_back(0);
+        responseTime.push_back(-1);
+        nameId.push_back(name.empty() ? defaultName : namePool.intern(name));
+        if (hasIo())
+        {
+            ioFirst.push_back(0);
+            ioCount.push_back(0);
+        }
+        return pid.size() - 1;
+    }
+
+    // Ajoute au dernier processus ajouté une entrée-sortie sur device, suivie
+    // d'une rafale de calcul de cpuTime
+    void addIoBurst(int device, int ioTime, int cpuTime)
+    {
+        if (!hasIo())
+        {
+            ioFirst.assign(size(), 0);
+            ioCount.assign(size(), 0);
+        }
+        size_t last = size() - 1;
+        if (ioCount[last] == 0)
+            ioFirst[last] = static_cast<uint32_t>(ioBursts.size());
+        ioBursts.push_back({device, ioTime, cpuTime});
+        ioCount[last]++;
+        ioDevices = std::max(ioDevices, device + 1);
+        burstTime[last] += cpuTime;
+    }
+
+    // Première rafale de calcul du processus index
+    int firstBurst(size_t index) const
+    {
+        int burst = burstTime[index];
+        if (hasIo())
+        {
+            for (uint32_t k = 0; k < ioCount[index]; ++k)
+                burst -= ioBursts[ioFirst[index] + k].cpuTime;
+        }
+        return burst;
+    }
+
+    // Réutilise la ligne index pour un nouveau processus, au nom par défaut
+    void replace(size_t index, int id, int arrival, int burst, int prio = 0)
+    {
+        pid[index] = id;
+        arrivalTime[index] = arrival;
+        burstTime[index] = burst;
+        priority[index] = prio;
+        remainingTime[index] = burst;
+        waitingTime[index] = 0;
+        turnaroundTime[index] = 0;
+        responseTime[index] = -1;
+        nameId[index] = defaultName;
+        if (hasIo())
+            ioCount[index] = 0;
+    }
+
+    size_t add(const Process &process)
+    {
+        return add(process.pid, process.arrivalTime, process.burstTime, process.priority, process.name);
+    }
+
+    std::string name(size_t index) const
+    {
+        if (nameId[index] == defaultName)
+            return "Processus " + std::to_string(pid[index]);
+        return namePool[nameId[index]];
+    }
+
+    Process row(size_t index) const
+    {
+        Process process(pid[index], name(index), arrivalTime[index], burstTime[index], priority[index]);
+        process.remainingTime = remainingTime[index];
+        process.waitingTime = waitingTime[index];
+        process.turnaroundTime = turnaroundTime[index];
+        process.responseTime = responseTime[index];
+        return process;
+    }
+
+    // Remet les colonnes de résultats à leur état initial avant une
+    // simulation ; le temps restant est celui de la première rafale
+    void resetResults()
+    {
+        std::copy(burstTime.begin(), burstTime.end(), remainingTime.begin());
+        if (hasIo())
+        {
+            for (size_t i = 0; i < size(); ++i)
+            {
+                if (ioCount[i] > 0)
+                    remainingTime[i] = firstBurst(i);
+            }
+        }
+        std::fill(waitingTime.begin(), waitingTime.end(), 0);
+        std::fill(turnaroundTime.begin(), turnaroundTime.end(), 0);
+        std::fill(responseTime.begin(), responseTime.end(), -1);
+    }
+
+    // Tri stable par date d'arrivée ; rien n'est déplacé si la table est déjà triée
+    void sortByArrival()
+    {
+        if (std::is_sorted(arrivalTime.begin(), arrivalTime.end()))
+            return;
+
+        std::vector<uint32_t> order(size());
+        std::iota(order.begin(), order.end(), 0u);
+        std::stable_sort(order.begin(), order.end(),
+                         [this](uint32_t a, uint32_t b)
+                         {
+                             return arrivalTime[a] < arrivalTime[b];
+                         });
+
+        std::vector<int> scratch(size());
+        for (auto *column : columns())
+        {
+            for (size_t i = 0; i < order.size(); ++i)
+                scratch[i] = (*column)[order[i]];
+            column->swap(scratch);
+        }
+        std::vector<int32_t> names(size());
+        for (size_t i = 0; i < order.size(); ++i)
+            names[i] = nameId[order[i]];
+        nameId.swap(names);
+        if (hasIo())
+        {
+            // Les rafales restent en place : seuls leurs repères suivent
+            std::vector<uint32_t> io(size());
+            for (auto *column : {&ioFirst, &ioCount})
+            {
+                for (size_t i = 0; i < order.size(); ++i)
+                    io[i] = (*column)[order[i]];
+                column->swap(io);
+            }
+        }
+    }
+
+private:
+    std::array<std::vector<int> *, 8> columns()
+    {
+        return {&pid, &arrivalTime, &burstTime, &priority, &remainingTime,
+                &waitingTime, &turnaroundTime, &responseTime};
+    }
+};
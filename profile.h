@@ -0,0 +1,236 @@
+#pragma once
+
+// Instrumentation des moteurs de simulation, activée à la compilation par
+// -DORDONNANCEUR_PROFILE=1. Désactivée (par défaut), les macros PROFILE_*
+// ne produisent aucun code : les moteurs compilés sont les mêmes qu'en
+// l'absence d'instrumentation.
+//
+// Activée, chaque fil accumule dans son propre Profile des compteurs
+// (événements, ajouts et retraits de la file des prêts, préemptions,
+// changements de contexte) et le temps passé dans chaque section. Le temps
+// est attribué à la section active la plus interne : une section imbriquée
+// est décomptée de celle qui l'englobe. Chaque lecture d'horloge coûte une
+// vingtaine de nanosecondes, ce qui ralentit nettement une simulation
+// instrumentée : les proportions entre sections restent significatives, pas
+// la durée totale.
+
+#ifndef ORDONNANCEUR_PROFILE
+#define ORDONNANCEUR_PROFILE 0
+#endif
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+enum ProfileSection
+{
+    ProfileEngine,   // boucle du moteur, hors sections suivantes
+    ProfileEvents,   // tas des événements
+    ProfileQueue,    // file des prêts : ajouts, retraits, préemption
+    ProfileDispatch, // élection et tranche, hors retrait de la file
+    ProfileSectionCount
+};
+
+constexpr const char *profileSectionNames[ProfileSectionCount] = {"engine", "event heap", "ready queue", "dispatch"};
+
+inline int64_t profileClock()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+struct Profile
+{
+    // Relevé périodique, pour les compteurs de la trace Chrome
+    struct Sample
+    {
+        int64_t time;
+        uint64_t events;
+        uint64_t pushes;
+        uint64_t pops;
+        int64_t sectionNs[ProfileSectionCount];
+    };
+
+    struct Run
+    {
+        std::string name;
+        int64_t start;
+        int64_t end;
+    };
+
+    static constexpr uint64_t sampleInterval = 65536; // événements entre deux relevés
+
+    uint64_t events = 0;
+    uint64_t arrivals = 0;
+    uint64_t sliceEnds = 0;
+    uint64_t wakeups = 0; // fins d'entrée-sortie
+    uint64_t pushes = 0;
+    uint64_t pops = 0;
+    uint64_t preemptions = 0;
+    uint64_t dispatches = 0;
+    uint64_t contextSwitches = 0;
+    uint64_t steals = 0;
+    int64_t sectionNs[ProfileSectionCount] = {};
+
+    std::vector<Sample> samples;
+    std::vector<Run> runs;
+    int64_t origin = profileClock();
+
+    // Section active et date depuis laquelle le temps lui est dû
+    ProfileSection current = ProfileEngine;
+    int64_t mark = 0;
+    uint64_t nextSample = sampleInterval;
+
+    // Attribue le temps écoulé à la section active et passe à section
+    void enter(ProfileSection section)
+    {
+        int64_t now = profileClock();
+        sectionNs[current] += now - mark;
+        mark = now;
+        current = section;
+    }
+
+    void sample()
+    {
+        if (events < nextSample)
+            return;
+        nextSample = events + sampleInterval;
+        Sample s = {profileClock() - origin, events, pushes, pops, {}};
+        for (int i = 0; i < ProfileSectionCount; ++i)
+            s.sectionNs[i] = sectionNs[i];
+        samples.push_back(s);
+    }
+
+    void clear()
+    {
+        *this = Profile();
+    }
+};
+
+// Profil du fil appelant
+inline Profile &threadProfile()
+{
+    thread_local Profile profile;
+    return profile;
+}
+
+// Section de code chronométrée, de la construction à la destruction
+class ProfileScope
+{
+private:
+    Profile &profile;
+    ProfileSection outer;
+
+public:
+    ProfileScope(Profile &p, ProfileSection section) : profile(p), outer(p.current)
+    {
+        profile.enter(section);
+    }
+
+    ~ProfileScope()
+    {
+        profile.enter(outer);
+    }
+};
+
+// Une simulation complète, reportée comme une tranche de la trace Chrome
+class ProfileRun
+{
+private:
+    Profile &profile;
+    std::string name;
+    int64_t start;
+
+public:
+    ProfileRun(Profile &p, std::string runName) : profile(p), name(std::move(runName))
+    {
+        start = profileClock();
+        profile.mark = start;
+        profile.current = ProfileEngine;
+    }
+
+    ~ProfileRun()
+    {
+        profile.enter(ProfileEngine);
+        profile.runs.push_back({name, start - profile.origin, profileClock() - profile.origin});
+    }
+};
+
+#if ORDONNANCEUR_PROFILE
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#define PROFILE_COUNT(counter) (threadProfile().counter++)
+#define PROFILE_SCOPE(section) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(threadProfile(), section)
+#define PROFILE_RUN(name) ProfileRun PROFILE_CONCAT(profileRun, __LINE__)(threadProfile(), name)
+#define PROFILE_SAMPLE() threadProfile().sample()
+#else
+#define PROFILE_COUNT(counter) ((void)0)
+#define PROFILE_SCOPE(section) ((void)0)
+#define PROFILE_RUN(name) ((void)0)
+#define PROFILE_SAMPLE() ((void)0)
+#endif
+
+inline void writeProfile(std::ostream &out, const Profile &profile)
+{
+    out << "Counter\t\tValue\n"
+        << "Events\t\t" << profile.events << "\n"
+        << "Arrivals\t" << profile.arrivals << "\n"
+        << "Slice ends\t" << profile.sliceEnds << "\n"
+        << "I/O wakeups\t" << profile.wakeups << "\n"
+        << "Queue pushes\t" << profile.pushes << "\n"
+        << "Queue pops\t" << profile.pops << "\n"
+        << "Preemptions\t" << profile.preemptions << "\n"
+        << "Dispatches\t" << profile.dispatches << "\n"
+        << "Context switches\t" << profile.contextSwitches << "\n"
+        << "Steals\t\t" << profile.steals << "\n";
+
+    int64_t total = 0;
+    for (int64_t ns : profile.sectionNs)
+        total += ns;
+    out << "\nSection\t\tms\tShare\tns/event\n";
+    for (int i = 0; i < ProfileSectionCount; ++i)
+    {
+        out << profileSectionNames[i] << "\t" << (i == ProfileEngine ? "\t" : "")
+            << profile.sectionNs[i] / 1e6 << "\t"
+            << (total == 0 ? 0 : 100.0 * profile.sectionNs[i] / total) << "%\t"
+            << (profile.events == 0 ? 0 : static_cast<double>(profile.sectionNs[i]) / profile.events) << "\n";
+    }
+}
+
+// Trace au format « Trace Event » de Chrome (chrome://tracing, Perfetto) :
+// une tranche par simulation et, tous les sampleInterval événements, les
+// compteurs cumulés et le temps passé dans chaque section
+inline void writeChromeTrace(std::ostream &out, const Profile &profile)
+{
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    const char *separator = "\n";
+    auto microseconds = [](int64_t ns)
+    {
+        return std::to_string(ns / 1000) + "." + std::to_string(ns % 1000 / 100);
+    };
+    for (const auto &run : profile.runs)
+    {
+        out << separator << "{\"name\":\"" << run.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":"
+            << microseconds(run.start) << ",\"dur\":" << microseconds(run.end - run.start) << "}";
+        separator = ",\n";
+    }
+    for (const auto &sample : profile.samples)
+    {
+        out << separator << "{\"name\":\"counters\",\"ph\":\"C\",\"pid\":1,\"ts\":" << microseconds(sample.time)
+            << ",\"args\":{\"events\":" << sample.events << ",\"pushes\":" << sample.pushes
+            << ",\"pops\":" << sample.pops << "}}";
+        separator = ",\n";
+        out << ",\n{\"name\":\"section ms\",\"ph\":\"C\",\"pid\":1,\"ts\":" << microseconds(sample.time)
+            << ",\"args\":{";
+        for (int i = 0; i < ProfileSectionCount; ++i)
+        {
+            out << (i > 0 ? "," : "") << "\"" << profileSectionNames[i] << "\":" << sample.sectionNs[i] / 1e6;
+        }
+        out << "}}";
+    }
+    out << "\n]}\n";
+}
@@ -0,0 +1,341 @@
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "policies.h"
+#include "process_table.h"
+#include "timeline.h"
+
+// Modèle de référence : le temps avance d'une unité à la fois et chaque
+// décision parcourt toute la file des prêts. Écrit pour être relu plutôt
+// que pour aller vite, il ne partage aucun code avec les politiques et sert
+// à vérifier le moteur à événements (voir verify.cpp). Il en reprend les
+// conventions : à une même date, les arrivées passent avant les fins de
+// tranche, dans l'ordre de la table triée par arrivée ; un élu préempté
+// retourne dans la file avant l'arrivant ; on élit une fois la date traitée.
+//
+// Entrées-sorties : un processus qui achève une rafale de calcul avant la
+// dernière se bloque sur le périphérique de son entrée-sortie. Chaque
+// périphérique sert ses demandes une à une dans l'ordre d'arrivée ; à une
+// même date, les fins de service passent après les arrivées et avant les fins
+// de tranche, périphérique de plus petit numéro d'abord, et le réveillé
+// retourne dans la file comme un arrivant. Le temps bloqué (en file ou en
+// service) n'est pas de l'attente.
+//
+// Politiques couvertes : fcfs, rr, sjf, priority et mlfq.
+class ReferenceSimulator
+{
+private:
+    static constexpr size_t none = static_cast<size_t>(-1);
+
+    std::string policy;
+    PolicyOptions options;
+
+    ProcessTable *table = nullptr;
+    std::vector<Segment> *segments = nullptr;
+    std::vector<size_t> ready; // dans l'ordre d'entrée
+    size_t running = none;
+    int64_t sliceStart = 0;
+    int64_t sliceEnd = 0;
+    int64_t lastPid = INT64_MIN; // dernier élu, pour compter les changements de contexte
+
+    // Entrées-sorties
+    struct Device
+    {
+        size_t serving = none;
+        int64_t end = 0; // fin du service en cours
+        std::vector<size_t> queue; // dans l'ordre des demandes
+    };
+    std::vector<Device> devices;
+    std::vector<uint32_t> phase; // entrées-sorties déjà faites
+    std::vector<int64_t> blockedSince;
+    std::vector<int64_t> blockedTime;
+
+    // MLFQ
+    std::vector<int> level;
+    std::vector<uint64_t> order; // rang d'entrée dans la file de son niveau
+    uint64_t nextOrder = 0;
+    int64_t nextBoost = 0;
+    int remainingAtDispatch = 0;
+    int dispatchedSlice = 0;
+
+    int levels() const
+    {
+        return std::max(1, options.levels);
+    }
+
+    int quantumOf(int l) const
+    {
+        int64_t base = options.quantum > 0 ? options.quantum : 2;
+        return static_cast<int>(std::min<int64_t>(base << std::min(l, 20), INT_MAX));
+    }
+
+    // Vrai si a passe avant b pour les politiques à clé
+    bool before(size_t a, size_t b) const
+    {
+        const ProcessTable &p = *table;
+        if (policy == "sjf")
+            return std::make_tuple(p.remainingTime[a], p.arrivalTime[a], p.pid[a]) <
+                   std::make_tuple(p.remainingTime[b], p.arrivalTime[b], p.pid[b]);
+        return std::make_tuple(p.priority[a], p.arrivalTime[a], p.pid[a]) <
+               std::make_tuple(p.priority[b], p.arrivalTime[b], p.pid[b]);
+    }
+
+    bool preempts(size_t arrived) const
+    {
+        if (policy == "sjf" || policy == "priority")
+            return before(arrived, running);
+        if (policy == "mlfq")
+            return level[arrived] < level[running]; // un arrivant entre au niveau 0, un réveillé au sien
+        return false;
+    }
+
+    void push(size_t index)
+    {
+        order[index] = nextOrder++;
+        ready.push_back(index);
+    }
+
+    // Position dans ready du prochain élu
+    size_t choose() const
+    {
+        size_t best = 0;
+        for (size_t i = 1; i < ready.size(); ++i)
+        {
+            size_t a = ready[i], b = ready[best];
+            bool better;
+            if (policy == "sjf" || policy == "priority")
+                better = before(a, b);
+            else if (policy == "mlfq")
+                better = std::make_pair(level[a], order[a]) < std::make_pair(level[b], order[b]);
+            else
+                better = false; // fcfs, rr : le premier entré
+            if (better)
+                best = i;
+        }
+        return best;
+    }
+
+    // MLFQ : tout le monde remonte au niveau 0, dans l'ordre (niveau, entrée)
+    void boost()
+    {
+        std::vector<size_t> sorted = ready;
+        std::sort(sorted.begin(), sorted.end(), [&](size_t a, size_t b)
+                  { return std::make_pair(level[a], order[a]) < std::make_pair(level[b], order[b]); });
+        std::fill(level.begin(), level.end(), 0);
+        for (size_t index : sorted)
+            order[index] = nextOrder++;
+    }
+
+    void dispatch(int64_t t)
+    {
+        if (policy == "mlfq" && options.boostInterval > 0 && t >= nextBoost)
+        {
+            boost();
+            while (nextBoost <= t)
+                nextBoost += options.boostInterval;
+        }
+
+        size_t position = choose();
+        running = ready[position];
+        ready.erase(ready.begin() + position);
+
+        ProcessTable &p = *table;
+        if (lastPid != INT64_MIN && lastPid != p.pid[running])
+            contextSwitches++;
+        lastPid = p.pid[running];
+        if (p.responseTime[running] == -1)
+            p.responseTime[running] = static_cast<int>(t - p.arrivalTime[running]);
+
+        int slice = p.remainingTime[running];
+        if (policy == "rr" && options.quantum > 0)
+            slice = std::min(options.quantum, slice);
+        if (policy == "mlfq")
+        {
+            dispatchedSlice = quantumOf(level[running]);
+            remainingAtDispatch = p.remainingTime[running];
+            slice = std::min(dispatchedSlice, slice);
+        }
+        sliceStart = t;
+        sliceEnd = t + slice;
+    }
+
+    const IoBurst &currentIo(size_t index) const
+    {
+        return table->ioBursts[table->ioFirst[index] + phase[index]];
+    }
+
+    void startIo(Device &device, size_t index, int64_t t)
+    {
+        device.serving = index;
+        device.end = t + currentIo(index).ioTime;
+    }
+
+    // Le processus devient prêt, à son arrivée ou à son réveil : il prend
+    // le processeur à l'élu si la politique le veut
+    void wake(size_t index, int64_t t)
+    {
+        if (running != none && preempts(index))
+            stop(t);
+        push(index);
+    }
+
+    // Fin de service sur le périphérique d : le servi repart avec sa rafale
+    // suivante, le périphérique passe à la demande suivante
+    void finishIo(size_t d, int64_t t)
+    {
+        Device &device = devices[d];
+        size_t index = device.serving;
+        table->remainingTime[index] = currentIo(index).cpuTime;
+        phase[index]++;
+        blockedTime[index] += t - blockedSince[index];
+        device.serving = none;
+        if (!device.queue.empty())
+        {
+            startIo(device, device.queue.front(), t);
+            device.queue.erase(device.queue.begin());
+        }
+        wake(index, t);
+    }
+
+    // Prochain périphérique dont le service s'achève à t, none s'il n'y en a pas
+    size_t dueDevice(int64_t t) const
+    {
+        for (size_t d = 0; d < devices.size(); ++d)
+        {
+            if (devices[d].serving != none && devices[d].end == t)
+                return d;
+        }
+        return none;
+    }
+
+    bool devicesIdle() const
+    {
+        for (const Device &device : devices)
+        {
+            if (device.serving != none)
+                return false;
+        }
+        return true;
+    }
+
+    void stop(int64_t t)
+    {
+        ProcessTable &p = *table;
+        if (t > sliceStart)
+        {
+            int pid = p.pid[running];
+            if (!segments->empty() && segments->back().pid == pid && segments->back().end == sliceStart)
+                segments->back().end = static_cast<int>(t);
+            else
+                segments->push_back({pid, static_cast<int>(sliceStart), static_cast<int>(t)});
+        }
+
+        // MLFQ : qui a consommé toute sa tranche descend, qu'il reste prêt ou se bloque
+        if (policy == "mlfq" && remainingAtDispatch - p.remainingTime[running] >= dispatchedSlice)
+            level[running] = std::min(level[running] + 1, levels() - 1);
+
+        if (p.remainingTime[running] > 0)
+        {
+            push(running);
+        }
+        else if (p.hasIo() && phase[running] < p.ioCount[running])
+        {
+            Device &device = devices[currentIo(running).device];
+            blockedSince[running] = t;
+            if (device.serving == none)
+                startIo(device, running, t);
+            else
+                device.queue.push_back(running);
+        }
+        else
+        {
+            p.turnaroundTime[running] = static_cast<int>(t - p.arrivalTime[running]);
+            p.waitingTime[running] = static_cast<int>(p.turnaroundTime[running] - p.burstTime[running] -
+                                                      blockedTime[running]);
+        }
+        running = none;
+    }
+
+public:
+    int64_t contextSwitches = 0; // élections d'un autre processus que le précédent
+
+    ReferenceSimulator(const std::string &policyName, const PolicyOptions &policyOptions)
+        : policy(policyName == "fifo" ? "fcfs" : policyName), options(policyOptions) {}
+
+    static bool supports(const std::string &name)
+    {
+        return name == "fcfs" || name == "fifo" || name == "rr" || name == "sjf" || name == "priority" ||
+               name == "mlfq";
+    }
+
+    // Simule la table, triée au préalable par date d'arrivée comme le fait
+    // Simulator::run(), et remplit la chronologie (segments contigus d'un
+    // même processus fusionnés, comme dans Timeline)
+    void run(ProcessTable &processes, std::vector<Segment> &timeline)
+    {
+        processes.sortByArrival();
+        processes.resetResults();
+        table = &processes;
+        segments = &timeline;
+        timeline.clear();
+        ready.clear();
+        running = none;
+        lastPid = INT64_MIN;
+        contextSwitches = 0;
+        level.assign(processes.size(), 0);
+        order.assign(processes.size(), 0);
+        nextOrder = 0;
+        nextBoost = options.boostInterval;
+        devices.assign(processes.ioDevices, Device());
+        phase.assign(processes.size(), 0);
+        blockedSince.assign(processes.size(), 0);
+        blockedTime.assign(processes.size(), 0);
+
+        size_t next = 0;
+        int64_t t = processes.empty() ? 0 : processes.arrivalTime[0];
+        while (next < processes.size() || running != none || !ready.empty() || !devicesIdle())
+        {
+            while (next < processes.size() && processes.arrivalTime[next] == t)
+            {
+                level[next] = 0;
+                wake(next++, t);
+            }
+            for (size_t d = dueDevice(t); d != none; d = dueDevice(t))
+                finishIo(d, t);
+            if (running != none && t == sliceEnd)
+            {
+                stop(t);
+                // Une entrée-sortie de durée nulle s'achève à la même date
+                for (size_t d = dueDevice(t); d != none; d = dueDevice(t))
+                    finishIo(d, t);
+            }
+            if (running == none && !ready.empty())
+                dispatch(t);
+
+            if (running != none)
+            {
+                processes.remainingTime[running]--;
+                t++;
+            }
+            else
+            {
+                // Processeur inactif jusqu'à la prochaine arrivée ou fin de service
+                int64_t wakeup = next < processes.size() ? processes.arrivalTime[next] : INT64_MAX;
+                for (const Device &device : devices)
+                {
+                    if (device.serving != none)
+                        wakeup = std::min(wakeup, device.end);
+                }
+                if (wakeup == INT64_MAX)
+                    break;
+                t = wakeup;
+            }
+        }
+    }
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "process_table.h"
+#include "timeline.h"
+
+// Tableau des résultats par processus
+inline void writeProcessResults(std::ostream &out, const ProcessTable &processes)
+{
+    out << "PID\tName\t\tArrival\t\tBurst\t\tPriority\t\tWaiting\t\tTurnaround\tResponse\n";
+    for (size_t i = 0; i < processes.size(); ++i)
+    {
+        out << processes.pid[i] << "\t";
+        if (processes.nameId[i] == ProcessTable::defaultName)
+            out << "Processus " << processes.pid[i];
+        else
+            out << processes.namePool[processes.nameId[i]];
+        out << "\t\t" << processes.arrivalTime[i] << "\t\t"
+            << processes.burstTime[i] << "\t\t" << processes.priority[i] << "\t\t"
+            << processes.waitingTime[i] << "\t\t" << processes.turnaroundTime[i] << "\t\t"
+            << processes.responseTime[i] << "\n";
+    }
+}
+
+// Tableau des résultats par processus, suivi des segments d'exécution
+inline void writeResults(std::ostream &out, const ProcessTable &processes,
+                         const Timeline &timeline)
+{
+    writeProcessResults(out, processes);
+    out << "\nPID\tStart\tEnd\n";
+    for (size_t i = 0; i < timeline.size(); ++i)
+    {
+        const Segment &segment = timeline[i];
+        out << segment.pid << "\t" << segment.start << "\t" << segment.end << "\n";
+    }
+}
+
+struct Averages
+{
+    double waiting = 0;
+    double turnaround = 0;
+    double response = 0;
+};
+
+// Moyennes des temps d'attente, de rotation et de réponse
+inline Averages computeAverages(const ProcessTable &processes)
+{
+    int64_t waiting = 0, turnaround = 0, response = 0;
+    for (size_t i = 0; i < processes.size(); ++i)
+    {
+        waiting += processes.waitingTime[i];
+        turnaround += processes.turnaroundTime[i];
+        response += processes.responseTime[i];
+    }
+
+    double count = processes.empty() ? 1 : processes.size();
+    return {waiting / count, turnaround / count, response / count};
+}
+
+inline void writeAverages(std::ostream &out, const ProcessTable &processes)
+{
+    Averages averages = computeAverages(processes);
+    out << "Processes\t" << processes.size() << "\n"
+        << "Avg waiting\t" << averages.waiting << "\n"
+        << "Avg turnaround\t" << averages.turnaround << "\n"
+        << "Avg response\t" << averages.response << "\n";
+}
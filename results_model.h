@@ -0,0 +1,347 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <new>
+#include <numeric>
+#include <string_view>
+#include <vector>
+#include <gtk/gtk.h>
+
+#include "process_table.h"
+
+// Modèle GtkTreeModel des résultats lu directement dans la table des
+// processus : rien n'est copié, la vue ne demande que les lignes visibles.
+// Le tri par colonne ne déplace qu'une permutation d'indices.
+enum ResultsColumn
+{
+    ResultsPid,
+    ResultsName,
+    ResultsArrival,
+    ResultsBurst,
+    ResultsPriority,
+    ResultsWaiting,
+    ResultsTurnaround,
+    ResultsResponse,
+    ResultsColumnCount
+};
+
+struct ResultsModel
+{
+    GObject parent;
+    const ProcessTable *processes;
+    std::vector<uint32_t> order; // ligne affichée → indice dans la table
+    gint stamp;
+    gint sortColumn;
+    GtkSortType sortOrder;
+};
+
+struct ResultsModelClass
+{
+    GObjectClass parentClass;
+};
+
+static void results_model_tree_model_init(GtkTreeModelIface *iface);
+static void results_model_sortable_init(GtkTreeSortableIface *iface);
+
+G_DEFINE_TYPE_WITH_CODE(ResultsModel, results_model, G_TYPE_OBJECT,
+                        G_IMPLEMENT_INTERFACE(GTK_TYPE_TREE_MODEL, results_model_tree_model_init)
+                            G_IMPLEMENT_INTERFACE(GTK_TYPE_TREE_SORTABLE, results_model_sortable_init))
+
+static ResultsModel *resultsModelOf(gpointer model)
+{
+    return G_TYPE_CHECK_INSTANCE_CAST(model, results_model_get_type(), ResultsModel);
+}
+
+// Les membres C++ sont construits et détruits à la main : GObject ne fait
+// qu'allouer une zone mise à zéro
+static void results_model_init(ResultsModel *model)
+{
+    new (&model->order) std::vector<uint32_t>();
+    model->processes = nullptr;
+    model->stamp = g_random_int();
+    model->sortColumn = GTK_TREE_SORTABLE_UNSORTED_SORT_COLUMN_ID;
+    model->sortOrder = GTK_SORT_ASCENDING;
+}
+
+static void resultsModelFinalize(GObject *object)
+{
+    resultsModelOf(object)->order.~vector();
+    G_OBJECT_CLASS(results_model_parent_class)->finalize(object);
+}
+
+static void results_model_class_init(ResultsModelClass *klass)
+{
+    G_OBJECT_CLASS(klass)->finalize = resultsModelFinalize;
+}
+
+// Nom affiché sans allocation : les noms par défaut sont formatés dans buffer
+static std::string_view resultsName(const ProcessTable &processes, uint32_t index, char (&buffer)[32])
+{
+    if (processes.nameId[index] == ProcessTable::defaultName)
+    {
+        int length = std::snprintf(buffer, sizeof buffer, "Processus %d", processes.pid[index]);
+        return std::string_view(buffer, length);
+    }
+    return processes.namePool[processes.nameId[index]];
+}
+
+// Rétablit l'ordre de la table puis applique le tri courant (stable : les
+// égalités gardent l'ordre d'arrivée)
+static void resultsModelSort(ResultsModel *model)
+{
+    std::vector<uint32_t> &order = model->order;
+    std::iota(order.begin(), order.end(), 0u);
+    if (model->sortColumn < 0 || model->processes == nullptr)
+        return;
+
+    const ProcessTable &processes = *model->processes;
+    bool descending = model->sortOrder == GTK_SORT_DESCENDING;
+    auto sortBy = [&](auto less)
+    {
+        std::stable_sort(order.begin(), order.end(),
+                         [&](uint32_t a, uint32_t b)
+                         {
+                             return descending ? less(b, a) : less(a, b);
+                         });
+    };
+    auto sortByColumn = [&](const std::vector<int> &column)
+    {
+        sortBy([&](uint32_t a, uint32_t b)
+               {
+                   return column[a] < column[b];
+               });
+    };
+
+    switch (model->sortColumn)
+    {
+    case ResultsPid:
+        sortByColumn(processes.pid);
+        break;
+    case ResultsName:
+        sortBy([&](uint32_t a, uint32_t b)
+               {
+                   // Deux noms par défaut : ordre numérique des pid
+                   if (processes.nameId[a] == ProcessTable::defaultName &&
+                       processes.nameId[b] == ProcessTable::defaultName)
+                       return processes.pid[a] < processes.pid[b];
+                   char bufferA[32], bufferB[32];
+                   return resultsName(processes, a, bufferA) < resultsName(processes, b, bufferB);
+               });
+        break;
+    case ResultsArrival:
+        sortByColumn(processes.arrivalTime);
+        break;
+    case ResultsBurst:
+        sortByColumn(processes.burstTime);
+        break;
+    case ResultsPriority:
+        sortByColumn(processes.priority);
+        break;
+    case ResultsWaiting:
+        sortByColumn(processes.waitingTime);
+        break;
+    case ResultsTurnaround:
+        sortByColumn(processes.turnaroundTime);
+        break;
+    case ResultsResponse:
+        sortByColumn(processes.responseTime);
+        break;
+    }
+}
+
+// Une ligne est désignée par sa position d'affichage, rangée dans user_data
+static gboolean resultsModelIter(ResultsModel *model, GtkTreeIter *iter, size_t row)
+{
+    if (row >= model->order.size())
+    {
+        iter->stamp = 0;
+        return FALSE;
+    }
+    iter->stamp = model->stamp;
+    iter->user_data = GSIZE_TO_POINTER(row);
+    return TRUE;
+}
+
+static size_t resultsModelRow(const GtkTreeIter *iter)
+{
+    return GPOINTER_TO_SIZE(iter->user_data);
+}
+
+static GtkTreeModelFlags resultsModelGetFlags(GtkTreeModel *)
+{
+    return GTK_TREE_MODEL_LIST_ONLY;
+}
+
+static gint resultsModelGetNColumns(GtkTreeModel *)
+{
+    return ResultsColumnCount;
+}
+
+static GType resultsModelGetColumnType(GtkTreeModel *, gint column)
+{
+    return column == ResultsName ? G_TYPE_STRING : G_TYPE_INT;
+}
+
+static gboolean resultsModelGetIter(GtkTreeModel *treeModel, GtkTreeIter *iter, GtkTreePath *path)
+{
+    if (gtk_tree_path_get_depth(path) != 1)
+        return FALSE;
+    return resultsModelIter(resultsModelOf(treeModel), iter, gtk_tree_path_get_indices(path)[0]);
+}
+
+static GtkTreePath *resultsModelGetPath(GtkTreeModel *, GtkTreeIter *iter)
+{
+    return gtk_tree_path_new_from_indices(static_cast<gint>(resultsModelRow(iter)), -1);
+}
+
+static void resultsModelGetValue(GtkTreeModel *treeModel, GtkTreeIter *iter, gint column, GValue *value)
+{
+    ResultsModel *model = resultsModelOf(treeModel);
+    const ProcessTable &processes = *model->processes;
+    uint32_t index = model->order[resultsModelRow(iter)];
+
+    if (column == ResultsName)
+    {
+        char buffer[32];
+        std::string_view name = resultsName(processes, index, buffer);
+        g_value_init(value, G_TYPE_STRING);
+        g_value_take_string(value, g_strndup(name.data(), name.size()));
+        return;
+    }
+
+    static const std::vector<int> ProcessTable::*const columns[] = {
+        &ProcessTable::pid, nullptr, &ProcessTable::arrivalTime, &ProcessTable::burstTime,
+        &ProcessTable::priority, &ProcessTable::waitingTime, &ProcessTable::turnaroundTime,
+        &ProcessTable::responseTime};
+    g_value_init(value, G_TYPE_INT);
+    g_value_set_int(value, (processes.*columns[column])[index]);
+}
+
+static gboolean resultsModelIterNext(GtkTreeModel *treeModel, GtkTreeIter *iter)
+{
+    return resultsModelIter(resultsModelOf(treeModel), iter, resultsModelRow(iter) + 1);
+}
+
+static gboolean resultsModelIterChildren(GtkTreeModel *treeModel, GtkTreeIter *iter, GtkTreeIter *parent)
+{
+    if (parent != nullptr)
+        return FALSE;
+    return resultsModelIter(resultsModelOf(treeModel), iter, 0);
+}
+
+static gboolean resultsModelIterHasChild(GtkTreeModel *, GtkTreeIter *)
+{
+    return FALSE;
+}
+
+static gint resultsModelIterNChildren(GtkTreeModel *treeModel, GtkTreeIter *iter)
+{
+    return iter == nullptr ? static_cast<gint>(resultsModelOf(treeModel)->order.size()) : 0;
+}
+
+static gboolean resultsModelIterNthChild(GtkTreeModel *treeModel, GtkTreeIter *iter, GtkTreeIter *parent, gint n)
+{
+    if (parent != nullptr || n < 0)
+        return FALSE;
+    return resultsModelIter(resultsModelOf(treeModel), iter, n);
+}
+
+static gboolean resultsModelIterParent(GtkTreeModel *, GtkTreeIter *, GtkTreeIter *)
+{
+    return FALSE;
+}
+
+static void results_model_tree_model_init(GtkTreeModelIface *iface)
+{
+    iface->get_flags = resultsModelGetFlags;
+    iface->get_n_columns = resultsModelGetNColumns;
+    iface->get_column_type = resultsModelGetColumnType;
+    iface->get_iter = resultsModelGetIter;
+    iface->get_path = resultsModelGetPath;
+    iface->get_value = resultsModelGetValue;
+    iface->iter_next = resultsModelIterNext;
+    iface->iter_children = resultsModelIterChildren;
+    iface->iter_has_child = resultsModelIterHasChild;
+    iface->iter_n_children = resultsModelIterNChildren;
+    iface->iter_nth_child = resultsModelIterNthChild;
+    iface->iter_parent = resultsModelIterParent;
+}
+
+static gboolean resultsModelGetSortColumnId(GtkTreeSortable *sortable, gint *column, GtkSortType *order)
+{
+    ResultsModel *model = resultsModelOf(sortable);
+    if (column != nullptr)
+        *column = model->sortColumn;
+    if (order != nullptr)
+        *order = model->sortOrder;
+    return model->sortColumn >= 0;
+}
+
+// Trie puis signale le nouvel ordre à la vue en une seule émission
+static void resultsModelSetSortColumnId(GtkTreeSortable *sortable, gint column, GtkSortType order)
+{
+    ResultsModel *model = resultsModelOf(sortable);
+    if (model->sortColumn == column && model->sortOrder == order)
+        return;
+    model->sortColumn = column;
+    model->sortOrder = order;
+
+    std::vector<uint32_t> previous = model->order;
+    resultsModelSort(model);
+    gtk_tree_sortable_sort_column_changed(sortable);
+
+    if (previous.empty())
+        return;
+    std::vector<gint> oldRowOf(previous.size()); // indice dans la table → ancienne ligne
+    for (size_t row = 0; row < previous.size(); ++row)
+        oldRowOf[previous[row]] = static_cast<gint>(row);
+    std::vector<gint> newOrder(previous.size()); // nouvelle ligne → ancienne ligne
+    for (size_t row = 0; row < previous.size(); ++row)
+        newOrder[row] = oldRowOf[model->order[row]];
+
+    GtkTreePath *path = gtk_tree_path_new();
+    gtk_tree_model_rows_reordered(GTK_TREE_MODEL(model), path, nullptr, newOrder.data());
+    gtk_tree_path_free(path);
+}
+
+// Seul le tri par colonne intégré est proposé
+static void resultsModelSetSortFunc(GtkTreeSortable *, gint, GtkTreeIterCompareFunc, gpointer, GDestroyNotify)
+{
+}
+
+static void resultsModelSetDefaultSortFunc(GtkTreeSortable *, GtkTreeIterCompareFunc, gpointer, GDestroyNotify)
+{
+}
+
+static gboolean resultsModelHasDefaultSortFunc(GtkTreeSortable *)
+{
+    return FALSE;
+}
+
+static void results_model_sortable_init(GtkTreeSortableIface *iface)
+{
+    iface->get_sort_column_id = resultsModelGetSortColumnId;
+    iface->set_sort_column_id = resultsModelSetSortColumnId;
+    iface->set_sort_func = resultsModelSetSortFunc;
+    iface->set_default_sort_func = resultsModelSetDefaultSortFunc;
+    iface->has_default_sort_func = resultsModelHasDefaultSortFunc;
+}
+
+inline GtkTreeModel *resultsModelNew()
+{
+    return GTK_TREE_MODEL(g_object_new(results_model_get_type(), nullptr));
+}
+
+// Rattache le modèle à une table (nullptr : modèle vide). Le nombre de lignes
+// change sans signal par ligne : le modèle doit être détaché de sa vue
+// pendant l'appel, et la table ne doit plus changer tant qu'il y est rattaché.
+inline void resultsModelSetTable(GtkTreeModel *treeModel, const ProcessTable *processes)
+{
+    ResultsModel *model = resultsModelOf(treeModel);
+    model->processes = processes;
+    model->order.resize(processes == nullptr ? 0 : processes->size());
+    model->stamp++;
+    resultsModelSort(model);
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// File FIFO sur un tampon circulaire : contrairement à std::deque, qui libère
+// et réalloue ses blocs au fil des ajouts et retraits, la capacité atteinte
+// est conservée, y compris par clear(). Une file réutilisée d'une simulation
+// à l'autre n'alloue plus rien une fois sa taille maximale atteinte.
+template <typename T>
+class RingQueue
+{
+private:
+    std::vector<T> buffer; // taille : puissance de deux, ou zéro
+    size_t head = 0;
+    size_t count = 0;
+
+    size_t mask() const
+    {
+        return buffer.size() - 1;
+    }
+
+    void grow()
+    {
+        std::vector<T> larger(buffer.empty() ? 16 : 2 * buffer.size());
+        for (size_t i = 0; i < count; ++i)
+        {
+            larger[i] = std::move(buffer[(head + i) & mask()]);
+        }
+        buffer.swap(larger);
+        head = 0;
+    }
+
+public:
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    size_t size() const
+    {
+        return count;
+    }
+
+    void clear()
+    {
+        head = 0;
+        count = 0;
+    }
+
+    void push_back(const T &value)
+    {
+        if (count == buffer.size())
+        {
+            grow();
+        }
+        buffer[(head + count) & mask()] = value;
+        count++;
+    }
+
+    T &front()
+    {
+        return buffer[head];
+    }
+
+    const T &front() const
+    {
+        return buffer[head];
+    }
+
+    void pop_front()
+    {
+        head = (head + 1) & mask();
+        count--;
+    }
+};
@@ -0,0 +1,649 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+#include "metrics.h"
+#include "policies.h"
+#include "process_table.h"
+#include "profile.h"
+#include "ring_queue.h"
+#include "timeline.h"
+#include "workload.h"
+
+// Suivi d'une simulation depuis un autre fil : compteurs publiés
+// périodiquement par le moteur, demande d'arrêt consultée au même rythme
+struct SimulationControl
+{
+    std::atomic<uint64_t> events{0};
+    std::atomic<uint64_t> completed{0};
+    std::atomic<bool> cancelled{false};
+};
+
+// Processus terminé d'une simulation en ligne, dont la ligne a été recyclée
+struct Completion
+{
+    int pid;
+    int arrivalTime;
+    int burstTime;
+    int priority;
+    int waitingTime;
+    int turnaroundTime;
+    int responseTime;
+};
+
+// Destinataire des résultats au fil de la simulation, pour les écrire sans
+// les garder en mémoire : segments d'exécution dans l'ordre chronologique
+// (tels que transmis à Timeline::append) et processus à leur terminaison
+class ScheduleSink
+{
+public:
+    virtual ~ScheduleSink() = default;
+
+    virtual void segment(int /*pid*/, int /*start*/, int /*end*/) {}
+    virtual void completed(const Completion &/*completion*/) {}
+};
+
+// Moteur à événements discrets : le temps saute directement d'une arrivée,
+// d'une fin d'entrée-sortie ou d'une fin de tranche à la suivante, quel que
+// soit l'écart entre elles. La préemption n'est examinée qu'aux instants où
+// un processus devient prêt (arrivée ou réveil).
+//
+// Un processus dont la rafale de calcul s'achève alors qu'il lui reste des
+// entrées-sorties (ProcessTable::ioBursts) se bloque : chaque périphérique
+// sert ses demandes une à une, dans l'ordre d'arrivée, pendant que le
+// processeur exécute les autres. Blocage et réveil coûtent un événement du
+// tas et un passage par la file des prêts, O(log n).
+//
+// Le moteur est paramétré par le type de la politique : instancié sur une
+// politique concrète scellée (voir engine.h), ses appels à la file des prêts
+// sont résolus à la compilation et intégrés à la boucle ; Simulator passe par
+// l'interface virtuelle et accepte toute politique.
+template <typename Policy>
+class BasicSimulator
+{
+private:
+    enum EventKind
+    {
+        Arrival = 0, // puis les réveils, puis les fins de tranche, à une même date
+        IoDone = 1,
+        SliceEnd = 2
+    };
+
+    struct Event
+    {
+        int time;
+        EventKind kind;
+        size_t index; // processus pour une arrivée, périphérique pour un réveil,
+                      // numéro d'élection pour une fin de tranche
+
+        bool operator>(const Event &other) const
+        {
+            if (time != other.time)
+                return time > other.time;
+            if (kind != other.kind)
+                return kind > other.kind;
+            return index > other.index;
+        }
+    };
+
+    std::priority_queue<Event, std::vector<Event>, std::greater<Event>> events;
+    ProcessTable &processes;
+    Policy &policy;
+    Timeline *timeline;
+
+    static constexpr size_t none = static_cast<size_t>(-1);
+
+    WorkloadSource *source = nullptr;
+    size_t running = none;
+    int sliceStart = 0;
+    int chargedUntil = 0;
+    size_t dispatchCount = 0; // une fin de tranche d'une élection préemptée est ignorée
+
+    static constexpr uint64_t publishInterval = 4096; // événements entre deux publications
+    SimulationControl *control = nullptr;
+    uint64_t eventCount = 0;
+    uint64_t completedCount = 0;
+    uint64_t nextPublish = 0;
+    bool stopped = false;
+
+    Metrics *metrics = nullptr;
+    ScheduleSink *sink = nullptr;
+    int64_t lastDispatched = noPid; // pid : en ligne, les lignes sont recyclées
+    static constexpr int64_t noPid = INT64_MIN;
+
+    size_t nextArrival = 0; // prochaine ligne à arriver, hors mode en ligne
+
+    // Entrées-sorties : avancement de chaque processus dans sa séquence de
+    // rafales et file de chaque périphérique ; vides sans entrée-sortie
+    struct IoProgress
+    {
+        uint32_t phase = 0; // entrées-sorties déjà faites
+        int blockedSince = 0;
+        int blockedTime = 0; // en file ou en service sur un périphérique
+    };
+
+    struct Device
+    {
+        size_t serving = none;
+        RingQueue<size_t> waiting;
+    };
+
+    std::vector<IoProgress> progress;
+    std::vector<Device> devices;
+
+    // Mode en ligne : les arrivées sont soumises une à une et la ligne d'un
+    // processus terminé est rendue pour la soumission suivante
+    bool online = false;
+    bool arrivalScheduled = false;
+    RingQueue<size_t> pendingArrivals; // soumises, derrière l'arrivée programmée
+    std::vector<size_t> freeSlots;
+    std::vector<Completion> completions;
+    int clock = 0; // date jusqu'à laquelle tout est traité
+    int lastArrival = 0; // date de la dernière soumission, qui peut devancer clock
+
+    // Publie l'avancement ; renvoie false si l'arrêt a été demandé
+    bool publish()
+    {
+        nextPublish = eventCount + publishInterval;
+        control->events.store(eventCount, std::memory_order_relaxed);
+        control->completed.store(completedCount, std::memory_order_relaxed);
+        return !control->cancelled.load(std::memory_order_relaxed);
+    }
+
+    void complete(size_t index, int endTime)
+    {
+        processes.turnaroundTime[index] = endTime - processes.arrivalTime[index];
+        processes.waitingTime[index] = processes.turnaroundTime[index] - processes.burstTime[index];
+        if (index < progress.size())
+        {
+            processes.waitingTime[index] -= progress[index].blockedTime;
+        }
+        completedCount++;
+        if (metrics != nullptr)
+        {
+            metrics->recordCompletion(processes.arrivalTime[index], processes.burstTime[index],
+                                      processes.waitingTime[index], processes.turnaroundTime[index],
+                                      processes.responseTime[index]);
+        }
+        if (online || sink != nullptr)
+        {
+            Completion completion = {processes.pid[index], processes.arrivalTime[index], processes.burstTime[index],
+                                     processes.priority[index], processes.waitingTime[index],
+                                     processes.turnaroundTime[index], processes.responseTime[index]};
+            if (sink != nullptr)
+            {
+                sink->completed(completion);
+            }
+            if (online)
+            {
+                completions.push_back(completion);
+                freeSlots.push_back(index);
+            }
+        }
+    }
+
+    // Accès à la file des prêts et au tas des événements, chronométrés si
+    // l'instrumentation est compilée (profile.h)
+    void enqueue(size_t index)
+    {
+        PROFILE_COUNT(pushes);
+        PROFILE_SCOPE(ProfileQueue);
+        policy.push(index);
+    }
+
+    size_t dequeue(int currentTime)
+    {
+        PROFILE_COUNT(pops);
+        PROFILE_SCOPE(ProfileQueue);
+        policy.advance(currentTime);
+        return policy.pop();
+    }
+
+    bool preempts(size_t arrived)
+    {
+        PROFILE_SCOPE(ProfileQueue);
+        return policy.preempts(arrived, running);
+    }
+
+    void schedule(const Event &event)
+    {
+        PROFILE_SCOPE(ProfileEvents);
+        events.push(event);
+    }
+
+    Event nextEvent()
+    {
+        PROFILE_SCOPE(ProfileEvents);
+        Event event = events.top();
+        events.pop();
+        return event;
+    }
+
+    // Vrai si le processus d'indice index existe, en le lisant depuis la source au besoin
+    bool available(size_t index)
+    {
+        if (index < processes.size())
+            return true;
+
+        TraceRecord record;
+        if (source == nullptr || !source->next(record))
+            return false;
+        appendProcess(processes, record, source->ioBursts());
+        return true;
+    }
+
+    void dispatch(int currentTime)
+    {
+        PROFILE_SCOPE(ProfileDispatch);
+        PROFILE_COUNT(dispatches);
+        running = dequeue(currentTime);
+        if (lastDispatched != noPid && lastDispatched != processes.pid[running])
+        {
+            PROFILE_COUNT(contextSwitches);
+            if (metrics != nullptr)
+            {
+                metrics->contextSwitches++;
+            }
+        }
+        lastDispatched = processes.pid[running];
+        if (processes.responseTime[running] == -1)
+        {
+            processes.responseTime[running] = currentTime - processes.arrivalTime[running];
+        }
+        sliceStart = currentTime;
+        chargedUntil = currentTime;
+        schedule({currentTime + policy.timeSlice(processes.remainingTime[running]), SliceEnd, ++dispatchCount});
+    }
+
+    // Décompte le temps exécuté par l'élu depuis la dernière mise à jour
+    void charge(int currentTime)
+    {
+        processes.remainingTime[running] -= currentTime - chargedUntil;
+        chargedUntil = currentTime;
+    }
+
+    IoProgress &progressOf(size_t index)
+    {
+        if (index >= progress.size())
+        {
+            progress.resize(processes.size());
+        }
+        return progress[index];
+    }
+
+    // Vrai si le processus a fini sa rafale mais pas ses entrées-sorties
+    bool waitsForIo(size_t index)
+    {
+        return processes.hasIo() && progressOf(index).phase < processes.ioCount[index];
+    }
+
+    const IoBurst &currentIo(size_t index) const
+    {
+        return processes.ioBursts[processes.ioFirst[index] + progress[index].phase];
+    }
+
+    void startIo(size_t device, size_t index, int currentTime)
+    {
+        devices[device].serving = index;
+        schedule({currentTime + currentIo(index).ioTime, IoDone, device});
+    }
+
+    // L'élu part en entrée-sortie : servi tout de suite si le périphérique
+    // est libre, sinon en file derrière les demandes précédentes
+    void block(size_t index, int currentTime)
+    {
+        policy.block(index);
+        progress[index].blockedSince = currentTime;
+        size_t device = currentIo(index).device;
+        if (device >= devices.size())
+        {
+            devices.resize(device + 1);
+        }
+        if (devices[device].serving == none)
+        {
+            startIo(device, index, currentTime);
+        }
+        else
+        {
+            devices[device].waiting.push_back(index);
+        }
+    }
+
+    // Fin d'entrée-sortie sur device : le processus servi redevient prêt avec
+    // sa rafale suivante et le périphérique passe à la demande suivante
+    void finishIo(size_t device, int currentTime)
+    {
+        Device &served = devices[device];
+        size_t index = served.serving;
+        const IoBurst &io = currentIo(index);
+        if (metrics != nullptr)
+        {
+            metrics->recordIo(io.device, io.ioTime);
+        }
+        processes.remainingTime[index] = io.cpuTime;
+        progress[index].phase++;
+        progress[index].blockedTime += currentTime - progress[index].blockedSince;
+
+        served.serving = none;
+        if (!served.waiting.empty())
+        {
+            size_t next = served.waiting.front();
+            served.waiting.pop_front();
+            startIo(device, next, currentTime);
+        }
+        wake(index, currentTime);
+    }
+
+    // Un processus devient prêt, à son arrivée ou à son réveil
+    void wake(size_t index, int currentTime)
+    {
+        if (running != none)
+        {
+            charge(currentTime);
+            if (preempts(index))
+            {
+                PROFILE_COUNT(preemptions);
+                stop(currentTime);
+            }
+        }
+        enqueue(index);
+    }
+
+    // Retire le processeur à l'élu : il retourne dans la file, part en
+    // entrée-sortie ou se termine
+    void stop(int currentTime)
+    {
+        charge(currentTime);
+        if (currentTime > sliceStart)
+        {
+            if (timeline != nullptr)
+            {
+                timeline->append(processes.pid[running], sliceStart, currentTime);
+            }
+            if (sink != nullptr)
+            {
+                sink->segment(processes.pid[running], sliceStart, currentTime);
+            }
+        }
+
+        if (processes.remainingTime[running] > 0)
+        {
+            enqueue(running);
+        }
+        else if (waitsForIo(running))
+        {
+            block(running, currentTime);
+        }
+        else
+        {
+            complete(running, currentTime);
+        }
+        running = none;
+    }
+
+    // Une seule arrivée en attente dans le tas : la suivante est programmée
+    // (et lue, pour une source) lorsque la précédente est traitée.
+    void scheduleNextArrival()
+    {
+        size_t index;
+        if (online)
+        {
+            arrivalScheduled = !pendingArrivals.empty();
+            if (!arrivalScheduled)
+                return;
+            index = pendingArrivals.front();
+            pendingArrivals.pop_front();
+        }
+        else
+        {
+            if (!available(nextArrival))
+                return;
+            index = nextArrival++;
+        }
+        schedule({processes.arrivalTime[index], Arrival, index});
+    }
+
+    void begin()
+    {
+        policy.attach(processes);
+        if (timeline != nullptr)
+        {
+            timeline->clear();
+        }
+        running = none;
+        nextArrival = 0;
+        progress.clear();
+        for (Device &device : devices)
+        {
+            device.serving = none;
+            device.waiting.clear();
+        }
+        clock = 0;
+        lastArrival = 0;
+        eventCount = 0;
+        completedCount = 0;
+        nextPublish = publishInterval;
+        stopped = false;
+        lastDispatched = noPid;
+        if (metrics != nullptr)
+        {
+            metrics->clear();
+        }
+    }
+
+    // Traite les événements antérieurs à limit, une date à la fois
+    void processBefore(int64_t limit)
+    {
+        while (!events.empty() && events.top().time < limit)
+        {
+            int currentTime = events.top().time;
+
+            // Traiter tous les événements de la même date avant d'élire
+            while (!events.empty() && events.top().time == currentTime)
+            {
+                Event event = nextEvent();
+                eventCount++;
+                PROFILE_COUNT(events);
+
+                if (event.kind == Arrival)
+                {
+                    PROFILE_COUNT(arrivals);
+                    wake(event.index, currentTime);
+                    scheduleNextArrival();
+                }
+                else if (event.kind == IoDone)
+                {
+                    PROFILE_COUNT(wakeups);
+                    finishIo(event.index, currentTime);
+                }
+                else if (event.index == dispatchCount && running != none)
+                {
+                    PROFILE_COUNT(sliceEnds);
+                    stop(currentTime);
+                }
+            }
+
+            if (running == none && !policy.empty())
+            {
+                dispatch(currentTime);
+            }
+            clock = std::max(clock, currentTime);
+            PROFILE_SAMPLE();
+
+            if (control != nullptr && eventCount >= nextPublish && !publish())
+            {
+                // Simulation abandonnée : l'état laissé ne doit pas fuir dans la suivante
+                stopped = true;
+                events = {};
+                running = none;
+                break;
+            }
+        }
+    }
+
+    void simulate()
+    {
+        PROFILE_RUN("simulation");
+        online = false;
+        begin();
+        scheduleNextArrival();
+        processBefore(INT64_MAX);
+        if (control != nullptr)
+        {
+            publish();
+        }
+    }
+
+public:
+    BasicSimulator(ProcessTable &p, Policy &pol, Timeline *t = nullptr)
+        : processes(p), policy(pol), timeline(t) {}
+
+    // Active le suivi de l'avancement et l'annulation par un autre fil
+    void setControl(SimulationControl *c)
+    {
+        control = c;
+    }
+
+    // Relève les mesures agrégées de chaque simulation dans m, remis à zéro au départ
+    void setMetrics(Metrics *m)
+    {
+        metrics = m;
+    }
+
+    // Transmet segments et terminaisons à s au fil de la simulation
+    void setSink(ScheduleSink *s)
+    {
+        sink = s;
+    }
+
+    // Vrai si la dernière simulation a été interrompue à la demande de control ;
+    // les résultats de la table sont alors incomplets
+    bool cancelled() const
+    {
+        return stopped;
+    }
+
+    // Simule les processus de la table, triés au préalable par date d'arrivée
+    void run()
+    {
+        processes.sortByArrival();
+        processes.resetResults();
+        simulate();
+    }
+
+    // Simule une trace lue au fil de l'eau : chaque processus n'est ajouté au
+    // la table qu'à son arrivée. La trace doit être triée par date d'arrivée ;
+    // renvoie false si la source s'est arrêtée sur une erreur.
+    bool run(WorkloadSource &trace)
+    {
+        processes.clear();
+        processes.reserve(trace.sizeHint());
+        trace.requireSortedArrivals();
+        source = &trace;
+        simulate();
+        source = nullptr;
+        return trace.error().empty();
+    }
+
+    // Simulation en ligne, pilotée par l'appelant : submit() ajoute un
+    // processus, advanceTo() fait avancer l'horloge et pollCompletions()
+    // récupère les processus terminés. La table ne contient que les
+    // processus présents dans le système ; sans chronologie, la mémoire ne
+    // dépend pas de la longueur de la simulation.
+    void startOnline()
+    {
+        processes.clear();
+        events = {};
+        pendingArrivals.clear();
+        freeSlots.clear();
+        completions.clear();
+        online = true;
+        arrivalScheduled = false;
+        begin();
+        // Pas de date avant la première soumission : les arrivées négatives restent possibles
+        clock = INT_MIN;
+        lastArrival = INT_MIN;
+    }
+
+    // Soumet un processus arrivant à arrivalTime, au plus tôt à la date
+    // courante et dans l'ordre des arrivées ; renvoie false sinon. L'horloge
+    // part de la première soumission ; ensuite, une arrivée future ne la fait
+    // pas avancer : seul advanceTo() le fait
+    bool submit(int pid, int arrivalTime, int burstTime, int priority = 0)
+    {
+        if (arrivalTime < clock || arrivalTime < lastArrival)
+            return false;
+        if (clock == INT_MIN)
+            clock = arrivalTime;
+        lastArrival = arrivalTime;
+
+        size_t slot;
+        if (freeSlots.empty())
+        {
+            slot = processes.add(pid, arrivalTime, burstTime, priority);
+        }
+        else
+        {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+            processes.replace(slot, pid, arrivalTime, burstTime, priority);
+        }
+
+        if (arrivalScheduled)
+        {
+            pendingArrivals.push_back(slot);
+        }
+        else
+        {
+            schedule({arrivalTime, Arrival, slot});
+            arrivalScheduled = true;
+        }
+        return true;
+    }
+
+    // Traite tout ce qui se passe avant time : les soumissions à time même
+    // restent possibles et sont traitées comme en simulation complète
+    void advanceTo(int time)
+    {
+        if (time <= clock)
+            return;
+        processBefore(time);
+        clock = time;
+    }
+
+    // Mène à terme tous les processus soumis
+    void finish()
+    {
+        processBefore(INT64_MAX);
+    }
+
+    // Processus soumis et pas encore terminés
+    size_t activeCount() const
+    {
+        return processes.size() - freeSlots.size();
+    }
+
+    // Date courante de la simulation en ligne, INT_MIN avant toute
+    // soumission ou avancée
+    int now() const
+    {
+        return clock;
+    }
+
+    // Remplace le contenu de out par les processus terminés depuis l'appel
+    // précédent ; les tampons sont échangés, sans copie ni allocation
+    size_t pollCompletions(std::vector<Completion> &out)
+    {
+        out.clear();
+        out.swap(completions);
+        return out.size();
+    }
+};
+
+using Simulator = BasicSimulator<SchedulingPolicy>;
@@ -0,0 +1,448 @@
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <queue>
+#include <vector>
+
+#include "metrics.h"
+#include "policies.h"
+#include "process_table.h"
+#include "profile.h"
+#include "timeline.h"
+
+// Paramètres de la simulation multiprocesseur ; les coûts sont en unités de
+// temps, payés par le processeur avant que l'élu ne s'exécute
+struct SmpConfig
+{
+    int cpus = 4;
+    int contextSwitchCost = 0; // élection d'un autre processus que le précédent du processeur
+    int migrationCost = 0;     // reprise sur un autre processeur que le précédent
+};
+
+struct CpuStats
+{
+    int64_t busyTime = 0;     // exécution des processus
+    int64_t overheadTime = 0; // changements de contexte et migrations
+    int64_t dispatches = 0;
+    int64_t contextSwitches = 0;
+    int64_t migrations = 0;
+    int64_t steals = 0; // processus pris dans la file d'un autre processeur
+};
+
+// Moteur à événements discrets multiprocesseur : une file des prêts (une
+// instance de la politique) par processeur. Un arrivant va à un processeur
+// inactif, sinon au moins chargé ; un processeur qui se retrouve sans travail
+// prend le prochain élu de la file la plus longue. Un processus préempté ou
+// en fin de tranche reste dans la file de son processeur.
+//
+// Les politiques à tas indexé réservent chacune un index de la taille de la
+// table : la mémoire croît en processeurs × processus. Les entrées-sorties
+// ne sont simulées que sur un seul processeur (simulator.h).
+class SmpSimulator
+{
+private:
+    enum EventKind
+    {
+        Arrival = 0, // traitées avant les fins de tranche à la même date
+        SliceEnd = 1
+    };
+
+    struct Event
+    {
+        int time;
+        EventKind kind;
+        uint32_t cpu;
+        size_t index; // processus pour une arrivée, numéro d'élection du processeur pour une fin de tranche
+
+        bool operator>(const Event &other) const
+        {
+            if (time != other.time)
+                return time > other.time;
+            if (kind != other.kind)
+                return kind > other.kind;
+            if (cpu != other.cpu)
+                return cpu > other.cpu;
+            return index > other.index;
+        }
+    };
+
+    static constexpr size_t none = static_cast<size_t>(-1);
+    static constexpr uint32_t noCpu = UINT32_MAX;
+    static constexpr int64_t noPid = INT64_MIN;
+
+    struct Cpu
+    {
+        std::unique_ptr<SchedulingPolicy> queue;
+        size_t waiting = 0; // processus dans la file
+        size_t running = none;
+        int dispatchTime = 0;
+        int sliceStart = 0; // après les coûts de l'élection
+        int chargedUntil = 0;
+        size_t dispatchCount = 0;
+        int64_t lastPid = noPid;
+        bool dirty = false; // à examiner avant la date suivante
+        CpuStats stats;
+    };
+
+    ProcessTable &processes;
+    SmpConfig config;
+    std::vector<Cpu> cpus;
+    std::vector<Timeline> *timelines; // une chronologie par processeur, facultative
+    Metrics *metrics = nullptr;
+
+    std::priority_queue<Event, std::vector<Event>, std::greater<Event>> events;
+    std::vector<uint32_t> lastCpu; // dernier processeur de chaque processus
+    std::vector<uint32_t> dirtyCpus;
+    uint32_t placementCursor = 0;
+    int firstArrival = 0;
+    int lastCompletion = 0;
+
+    void markDirty(uint32_t c)
+    {
+        if (!cpus[c].dirty)
+        {
+            cpus[c].dirty = true;
+            dirtyCpus.push_back(c);
+        }
+    }
+
+    void enqueue(uint32_t c, size_t index)
+    {
+        PROFILE_COUNT(pushes);
+        PROFILE_SCOPE(ProfileQueue);
+        cpus[c].queue->push(index);
+        cpus[c].waiting++;
+        markDirty(c);
+    }
+
+    void complete(size_t index, int endTime)
+    {
+        processes.turnaroundTime[index] = endTime - processes.arrivalTime[index];
+        processes.waitingTime[index] = processes.turnaroundTime[index] - processes.burstTime[index];
+        lastCompletion = std::max(lastCompletion, endTime);
+        if (metrics != nullptr)
+        {
+            metrics->recordCompletion(processes.arrivalTime[index], processes.burstTime[index],
+                                      processes.waitingTime[index], processes.turnaroundTime[index],
+                                      processes.responseTime[index]);
+        }
+    }
+
+    // Décompte le temps exécuté par l'élu depuis la dernière mise à jour ;
+    // rien pendant les coûts de l'élection
+    void charge(Cpu &cpu, int currentTime)
+    {
+        if (currentTime > cpu.chargedUntil)
+        {
+            processes.remainingTime[cpu.running] -= currentTime - cpu.chargedUntil;
+            cpu.chargedUntil = currentTime;
+        }
+    }
+
+    void stop(uint32_t c, int currentTime)
+    {
+        Cpu &cpu = cpus[c];
+        charge(cpu, currentTime);
+        cpu.stats.overheadTime += std::min(currentTime, cpu.sliceStart) - cpu.dispatchTime;
+        if (currentTime > cpu.sliceStart)
+        {
+            cpu.stats.busyTime += currentTime - cpu.sliceStart;
+            if (timelines != nullptr)
+            {
+                (*timelines)[c].append(processes.pid[cpu.running], cpu.sliceStart, currentTime);
+            }
+        }
+
+        size_t index = cpu.running;
+        cpu.running = none;
+        markDirty(c);
+        if (processes.remainingTime[index] > 0)
+        {
+            enqueue(c, index);
+        }
+        else
+        {
+            complete(index, currentTime);
+        }
+    }
+
+    void dispatch(uint32_t c, int currentTime)
+    {
+        PROFILE_SCOPE(ProfileDispatch);
+        PROFILE_COUNT(dispatches);
+        PROFILE_COUNT(pops);
+        Cpu &cpu = cpus[c];
+        size_t index;
+        {
+            PROFILE_SCOPE(ProfileQueue);
+            cpu.queue->advance(currentTime);
+            index = cpu.queue->pop();
+        }
+        cpu.waiting--;
+
+        int cost = 0;
+        if (cpu.lastPid != noPid && cpu.lastPid != processes.pid[index])
+        {
+            PROFILE_COUNT(contextSwitches);
+            cpu.stats.contextSwitches++;
+            cost += config.contextSwitchCost;
+            if (metrics != nullptr)
+            {
+                metrics->contextSwitches++;
+            }
+        }
+        if (lastCpu[index] != noCpu && lastCpu[index] != c)
+        {
+            cpu.stats.migrations++;
+            cost += config.migrationCost;
+        }
+        cpu.stats.dispatches++;
+        lastCpu[index] = c;
+        cpu.lastPid = processes.pid[index];
+
+        cpu.running = index;
+        cpu.dispatchTime = currentTime;
+        cpu.sliceStart = currentTime + cost;
+        cpu.chargedUntil = cpu.sliceStart;
+        if (processes.responseTime[index] == -1)
+        {
+            processes.responseTime[index] = cpu.sliceStart - processes.arrivalTime[index];
+        }
+        events.push({cpu.sliceStart + cpu.queue->timeSlice(processes.remainingTime[index]), SliceEnd, c,
+                     ++cpu.dispatchCount});
+    }
+
+    // Processeur d'un arrivant : le premier inactif sans file, sinon le moins
+    // chargé. La recherche part du processeur suivant le dernier choisi, pour
+    // que les premiers numéros ne reçoivent pas tout en faible charge.
+    uint32_t placement()
+    {
+        uint32_t best = 0;
+        size_t bestLoad = SIZE_MAX;
+        for (uint32_t i = 0; i < cpus.size(); ++i)
+        {
+            uint32_t c = (placementCursor + i) % cpus.size();
+            size_t load = cpus[c].waiting + (cpus[c].running != none ? 1 : 0);
+            if (load < bestLoad)
+            {
+                best = c;
+                bestLoad = load;
+                if (load == 0)
+                    break;
+            }
+        }
+        placementCursor = best + 1;
+        return best;
+    }
+
+    void arrive(size_t index, int currentTime)
+    {
+        uint32_t c = placement();
+        Cpu &cpu = cpus[c];
+        if (cpu.running != none)
+        {
+            charge(cpu, currentTime);
+            if (cpu.queue->preempts(index, cpu.running))
+            {
+                PROFILE_COUNT(preemptions);
+                stop(c, currentTime);
+            }
+        }
+        enqueue(c, index);
+    }
+
+    // Prend le prochain élu de la file la plus longue ; false si toutes sont vides
+    bool steal(uint32_t thief)
+    {
+        uint32_t victim = noCpu;
+        size_t longest = 0;
+        for (uint32_t c = 0; c < cpus.size(); ++c)
+        {
+            if (c != thief && cpus[c].waiting > longest)
+            {
+                victim = c;
+                longest = cpus[c].waiting;
+            }
+        }
+        if (victim == noCpu)
+            return false;
+
+        PROFILE_COUNT(steals);
+        PROFILE_COUNT(pops);
+        PROFILE_COUNT(pushes);
+        PROFILE_SCOPE(ProfileQueue);
+        size_t index = cpus[victim].queue->steal();
+        cpus[victim].waiting--;
+        cpus[thief].queue->push(index);
+        cpus[thief].waiting++;
+        cpus[thief].stats.steals++;
+        return true;
+    }
+
+    void simulate()
+    {
+        PROFILE_RUN("smp simulation");
+        events = {};
+        lastCpu.assign(processes.size(), noCpu);
+        dirtyCpus.clear();
+        placementCursor = 0;
+        for (Cpu &cpu : cpus)
+        {
+            cpu.queue->attach(processes);
+            cpu.waiting = 0;
+            cpu.running = none;
+            cpu.dispatchCount = 0;
+            cpu.lastPid = noPid;
+            cpu.dirty = false;
+            cpu.stats = CpuStats();
+        }
+        if (timelines != nullptr)
+        {
+            timelines->resize(cpus.size());
+            for (Timeline &timeline : *timelines)
+                timeline.clear();
+        }
+        if (metrics != nullptr)
+        {
+            metrics->clear();
+        }
+        firstArrival = processes.empty() ? 0 : processes.arrivalTime[0];
+        lastCompletion = firstArrival;
+
+        // Une seule arrivée en attente dans le tas, comme pour Simulator
+        size_t nextArrival = 0;
+        if (nextArrival < processes.size())
+        {
+            events.push({processes.arrivalTime[0], Arrival, 0, nextArrival++});
+        }
+
+        while (!events.empty())
+        {
+            int currentTime = events.top().time;
+
+            // Traiter tous les événements de la même date avant d'élire
+            while (!events.empty() && events.top().time == currentTime)
+            {
+                Event event = events.top();
+                events.pop();
+                PROFILE_COUNT(events);
+
+                if (event.kind == Arrival)
+                {
+                    PROFILE_COUNT(arrivals);
+                    arrive(event.index, currentTime);
+                    if (nextArrival < processes.size())
+                    {
+                        events.push({processes.arrivalTime[nextArrival], Arrival, 0, nextArrival});
+                        nextArrival++;
+                    }
+                }
+                else if (event.index == cpus[event.cpu].dispatchCount && cpus[event.cpu].running != none)
+                {
+                    PROFILE_COUNT(sliceEnds);
+                    stop(event.cpu, currentTime);
+                }
+            }
+
+            // Seuls les processeurs touchés à cette date peuvent avoir à élire :
+            // un arrivant va toujours d'abord à un processeur inactif. Chacun
+            // élit d'abord dans sa file ; ceux qui restent sans travail volent
+            // ensuite, pour ne pas prendre un processus que son processeur
+            // allait reprendre à la même date.
+            for (uint32_t c : dirtyCpus)
+            {
+                if (cpus[c].running == none && cpus[c].waiting > 0)
+                {
+                    dispatch(c, currentTime);
+                }
+            }
+            for (uint32_t c : dirtyCpus)
+            {
+                cpus[c].dirty = false;
+                if (cpus[c].running == none && steal(c))
+                {
+                    dispatch(c, currentTime);
+                }
+            }
+            dirtyCpus.clear();
+            PROFILE_SAMPLE();
+        }
+    }
+
+public:
+    // makeQueue crée la file des prêts (la politique) de chaque processeur
+    SmpSimulator(ProcessTable &p, const SmpConfig &c,
+                 const std::function<std::unique_ptr<SchedulingPolicy>()> &makeQueue,
+                 std::vector<Timeline> *t = nullptr)
+        : processes(p), config(c), cpus(std::max(1, c.cpus)), timelines(t)
+    {
+        for (Cpu &cpu : cpus)
+        {
+            cpu.queue = makeQueue();
+        }
+    }
+
+    void setMetrics(Metrics *m)
+    {
+        metrics = m;
+    }
+
+    // Simule les processus de la table, triés au préalable par date d'arrivée
+    void run()
+    {
+        processes.sortByArrival();
+        processes.resetResults();
+        simulate();
+    }
+
+    std::vector<CpuStats> stats() const
+    {
+        std::vector<CpuStats> result;
+        for (const Cpu &cpu : cpus)
+            result.push_back(cpu.stats);
+        return result;
+    }
+
+    // Durée entre la première arrivée et la dernière terminaison
+    int64_t makespan() const
+    {
+        return int64_t(lastCompletion) - firstArrival;
+    }
+
+    double utilization(size_t cpu) const
+    {
+        return makespan() == 0 ? 0 : static_cast<double>(cpus[cpu].stats.busyTime) / makespan();
+    }
+
+    // Déséquilibre de charge : temps d'exécution du processeur le plus occupé
+    // rapporté à la moyenne, moins un (0 pour une répartition parfaite)
+    double loadImbalance() const
+    {
+        int64_t total = 0, busiest = 0;
+        for (const Cpu &cpu : cpus)
+        {
+            total += cpu.stats.busyTime;
+            busiest = std::max(busiest, cpu.stats.busyTime);
+        }
+        return total == 0 ? 0 : static_cast<double>(busiest) * cpus.size() / total - 1;
+    }
+};
+
+inline void writeSmpStats(std::ostream &out, const SmpSimulator &simulator)
+{
+    std::vector<CpuStats> stats = simulator.stats();
+    out << "CPU\tBusy\tOverhead\tUtilization\tDispatches\tSwitches\tMigrations\tSteals\n";
+    for (size_t c = 0; c < stats.size(); ++c)
+    {
+        out << c << "\t" << stats[c].busyTime << "\t" << stats[c].overheadTime << "\t\t"
+            << simulator.utilization(c) << "\t" << stats[c].dispatches << "\t\t"
+            << stats[c].contextSwitches << "\t\t" << stats[c].migrations << "\t\t" << stats[c].steals << "\n";
+    }
+    out << "Makespan\t" << simulator.makespan() << "\n"
+        << "Load imbalance\t" << simulator.loadImbalance() << "\n";
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "engine.h"
+#include "metrics.h"
+#include "policies.h"
+#include "process_table.h"
+#include "results.h"
+
+// Une configuration du balayage : politique et quantum (ignoré hors tourniquet)
+struct SweepConfig
+{
+    std::string policy;
+    int quantum = 0;
+};
+
+struct SweepResult
+{
+    SweepConfig config;
+    Averages averages;
+    Metrics metrics;
+};
+
+// Produit cartésien politiques × quantums ; seules les politiques à quantum
+// (rr, mlfq) sont déclinées pour chaque valeur
+inline std::vector<SweepConfig> sweepGrid(const std::vector<std::string> &policies,
+                                          const std::vector<int> &quantums)
+{
+    std::vector<SweepConfig> configs;
+    for (const auto &policy : policies)
+    {
+        const PolicyEntry *entry = findPolicy(policy);
+        if (entry != nullptr && entry->usesQuantum)
+        {
+            for (int quantum : quantums)
+                configs.push_back({policy, quantum});
+        }
+        else
+        {
+            configs.push_back({policy, 0});
+        }
+    }
+    return configs;
+}
+
+// Simule chaque configuration sur la même charge, en parallèle. Chaque fil
+// travaille dans son propre contexte, avec sa copie de la table, et prend la configuration suivante
+// dès qu'il a fini la précédente. Les résultats suivent l'ordre de configs ;
+// une politique inconnue laisse des moyennes nulles. Les paramètres autres
+// que le quantum sont pris dans options.
+inline std::vector<SweepResult> runSweep(ProcessTable &workload, const std::vector<SweepConfig> &configs,
+                                         unsigned threads = std::thread::hardware_concurrency(),
+                                         const PolicyOptions &options = PolicyOptions())
+{
+    // Trié une seule fois ici : les copies n'ont plus rien à déplacer
+    workload.sortByArrival();
+
+    std::vector<SweepResult> results(configs.size());
+    std::atomic<size_t> nextConfig{0};
+
+    auto worker = [&]()
+    {
+        SimulationContext context;
+        context.load(workload);
+        size_t index;
+        while ((index = nextConfig.fetch_add(1, std::memory_order_relaxed)) < configs.size())
+        {
+            const SweepConfig &config = configs[index];
+            results[index].config = config;
+
+            PolicyOptions configOptions = options;
+            configOptions.quantum = config.quantum;
+            if (!context.run(config.policy, configOptions))
+                continue;
+            results[index].metrics = context.lastMetrics();
+            results[index].averages = computeAverages(context.table());
+        }
+    };
+
+    threads = std::max(1u, std::min<unsigned>(threads, configs.size()));
+    std::vector<std::thread> pool;
+    for (unsigned i = 1; i < threads; ++i)
+    {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : pool)
+    {
+        thread.join();
+    }
+    return results;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Intervalle pendant lequel un processus a occupé le processeur
+struct Segment
+{
+    int pid;
+    int start;
+    int end;
+};
+
+// Chronologie d'exécution en ajout seul, stockée par blocs de taille fixe :
+// un ajout ne déplace jamais les segments existants et n'alloue qu'un bloc
+// tous les blockSize segments. clear() conserve les blocs pour la simulation
+// suivante.
+class Timeline
+{
+private:
+    static constexpr size_t blockSize = 4096;
+
+    std::vector<std::unique_ptr<Segment[]>> blocks;
+    size_t count = 0;
+
+public:
+    // Un segment qui prolonge immédiatement le précédent du même processus
+    // (tourniquet avec un seul prêt, par exemple) est fusionné avec lui
+    void append(int pid, int start, int end)
+    {
+        if (count > 0)
+        {
+            Segment &last = (*this)[count - 1];
+            if (last.pid == pid && last.end == start)
+            {
+                last.end = end;
+                return;
+            }
+        }
+
+        if (count == blocks.size() * blockSize)
+        {
+            blocks.emplace_back(new Segment[blockSize]);
+        }
+        (*this)[count++] = {pid, start, end};
+    }
+
+    void clear()
+    {
+        count = 0;
+    }
+
+    size_t size() const
+    {
+        return count;
+    }
+
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    Segment &operator[](size_t index)
+    {
+        return blocks[index / blockSize][index % blockSize];
+    }
+
+    const Segment &operator[](size_t index) const
+    {
+        return blocks[index / blockSize][index % blockSize];
+    }
+
+    // Fin du dernier segment, 0 si la chronologie est vide
+    int endTime() const
+    {
+        return count == 0 ? 0 : (*this)[count - 1].end;
+    }
+};
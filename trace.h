@@ -0,0 +1,194 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "workload.h"
+
+// Format binaire de trace : un en-tête de 16 octets suivi de `count`
+// enregistrements TraceRecord de taille fixe (int32 dans l'ordre natif),
+// triés par date d'arrivée, ce qui permet de le projeter en mémoire tel quel.
+struct TraceHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint64_t count;
+};
+
+static_assert(sizeof(TraceHeader) == 16, "TraceHeader doit rester un en-tête de 16 octets");
+
+constexpr char traceMagic[4] = {'O', 'R', 'D', 'T'};
+constexpr uint32_t traceVersion = 1;
+
+// Trace binaire projetée en mémoire, parcourue séquentiellement
+class MappedTrace : public WorkloadSource
+{
+private:
+    void *mapping = MAP_FAILED;
+    size_t length = 0;
+    const TraceRecord *records = nullptr;
+    size_t count = 0;
+    size_t cursor = 0;
+
+public:
+    explicit MappedTrace(const std::string &path)
+    {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            fail("impossible d'ouvrir " + path);
+            return;
+        }
+
+        struct stat info;
+        if (fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= sizeof(TraceHeader))
+        {
+            length = info.st_size;
+            mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        ::close(fd);
+
+        if (mapping == MAP_FAILED)
+        {
+            fail(path + " : trace binaire illisible");
+            return;
+        }
+        madvise(mapping, length, MADV_SEQUENTIAL);
+
+        const TraceHeader *header = static_cast<const TraceHeader *>(mapping);
+        if (std::memcmp(header->magic, traceMagic, sizeof(traceMagic)) != 0 ||
+            header->version != traceVersion ||
+            header->count > (length - sizeof(TraceHeader)) / sizeof(TraceRecord))
+        {
+            fail(path + " : en-tête de trace invalide");
+            return;
+        }
+        count = header->count;
+        records = reinterpret_cast<const TraceRecord *>(header + 1);
+    }
+
+    ~MappedTrace() override
+    {
+        if (mapping != MAP_FAILED)
+        {
+            munmap(mapping, length);
+        }
+    }
+
+    MappedTrace(const MappedTrace &) = delete;
+    MappedTrace &operator=(const MappedTrace &) = delete;
+
+    bool isOpen() const
+    {
+        return records != nullptr;
+    }
+
+    size_t size() const
+    {
+        return count;
+    }
+
+    const TraceRecord &operator[](size_t index) const
+    {
+        return records[index];
+    }
+
+    bool next(TraceRecord &record) override
+    {
+        if (cursor >= count || !error().empty())
+            return false;
+        record = records[cursor++];
+        return accept(record, "enregistrement", static_cast<long>(cursor));
+    }
+
+    size_t sizeHint() const override
+    {
+        return count;
+    }
+};
+
+// Écrit une trace binaire enregistrement par enregistrement ; le nombre
+// d'enregistrements de l'en-tête est renseigné à la fermeture.
+class TraceWriter
+{
+private:
+    std::FILE *file = nullptr;
+    uint64_t count = 0;
+    int32_t lastArrival = INT32_MIN;
+
+public:
+    explicit TraceWriter(const std::string &path)
+    {
+        file = std::fopen(path.c_str(), "wb");
+        if (file != nullptr)
+        {
+            std::setvbuf(file, nullptr, _IOFBF, 1 << 20);
+            TraceHeader header = {{traceMagic[0], traceMagic[1], traceMagic[2], traceMagic[3]}, traceVersion, 0};
+            std::fwrite(&header, sizeof(header), 1, file);
+        }
+    }
+
+    ~TraceWriter()
+    {
+        close();
+    }
+
+    TraceWriter(const TraceWriter &) = delete;
+    TraceWriter &operator=(const TraceWriter &) = delete;
+
+    bool isOpen() const
+    {
+        return file != nullptr;
+    }
+
+    // false si l'enregistrement arrive avant le précédent, si sa durée n'est
+    // pas positive ou si l'écriture échoue
+    bool write(const TraceRecord &record)
+    {
+        if (file == nullptr || record.arrivalTime < lastArrival || record.burstTime <= 0)
+            return false;
+        lastArrival = record.arrivalTime;
+        count++;
+        return std::fwrite(&record, sizeof(record), 1, file) == 1;
+    }
+
+    bool close()
+    {
+        if (file == nullptr)
+            return false;
+        bool ok = std::fseek(file, offsetof(TraceHeader, count), SEEK_SET) == 0 &&
+                  std::fwrite(&count, sizeof(count), 1, file) == 1;
+        ok = std::fclose(file) == 0 && ok;
+        file = nullptr;
+        return ok;
+    }
+};
+
+// Ouvre une trace binaire ou CSV selon son contenu ("-" : CSV sur l'entrée standard)
+inline std::unique_ptr<WorkloadSource> openWorkload(const std::string &path)
+{
+    if (path != "-")
+    {
+        char magic[sizeof(traceMagic)] = {};
+        std::FILE *file = std::fopen(path.c_str(), "rb");
+        if (file != nullptr)
+        {
+            size_t read = std::fread(magic, 1, sizeof(magic), file);
+            std::fclose(file);
+            if (read == sizeof(magic) && std::memcmp(magic, traceMagic, sizeof(magic)) == 0)
+            {
+                return std::make_unique<MappedTrace>(path);
+            }
+        }
+    }
+    return std::make_unique<CsvReader>(path);
+}
@@ -0,0 +1,787 @@
+// Vérification différentielle du moteur à événements : des charges tirées au
+// hasard sont simulées par le moteur (boucle spécialisée et boucle virtuelle)
+// et par le modèle de référence de reference.h, qui avance d'une unité de
+// temps à la fois. Les résultats de chaque processus et les chronologies
+// doivent être identiques, ainsi que les changements de contexte et le temps
+// de service des périphériques ; un essai sur trois fait des entrées-sorties.
+// Le moteur est aussi mené en ligne, les arrivées soumises en avance sur
+// l'horloge. Les politiques qui retiennent l'élu entre pop() et son retour
+// (mlfq, cfs) passent enfin par SmpSimulator, avec et sans vols témoins. Au
+// préalable, les lecteurs de traces (CSV et binaire) doivent refuser les
+// rafales invalides, et des charges à entrées-sorties calculées à la main
+// doivent être retrouvées. Chaque essai est reproductible à partir de sa
+// graine, affichée en cas d'écart avec la charge et les paramètres.
+// Compilation : g++ -O2 -std=c++17 verify.cpp -o verify
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "engine.h"
+#include "generator.h"
+#include "online.h"
+#include "options.h"
+#include "policies.h"
+#include "process_table.h"
+#include "reference.h"
+#include "smp.h"
+#include "timeline.h"
+#include "trace.h"
+#include "workload.h"
+
+static void usage(const char *program)
+{
+    std::cerr << "Usage : " << program << " [options]\n"
+              << "  -p, --policy <liste>   politiques vérifiées (défaut : fcfs,rr,sjf,priority,mlfq)\n"
+              << "  -n, --trials <n>       essais par politique (défaut : 1000)\n"
+              << "  -m, --max <n>          processus par charge, au plus (défaut : 200)\n"
+              << "  -s, --seed <n>         graine du premier essai (défaut : 1)\n";
+}
+
+// Charge et paramètres d'un essai, tirés de sa graine : arrivées plus ou
+// moins groupées (beaucoup d'arrivées simultanées), durées exponentielles ou
+// de Pareto, pid ni consécutifs ni dans l'ordre des lignes, lignes à trier,
+// dates d'arrivée parfois négatives. Avec withIo, un essai sur trois fait
+// des entrées-sorties sur un à trois périphériques, dont quelques-unes de
+// durée nulle.
+static void drawTrial(uint64_t seed, size_t maxProcesses, bool withIo, ProcessTable &workload,
+                      PolicyOptions &options)
+{
+    WorkloadRandom random(seed);
+    WorkloadSpec spec;
+    spec.seed = seed;
+    spec.count = 1 + random.below(static_cast<int>(maxProcesses));
+    spec.meanInterarrival = 0.25 + 8 * random.uniform();
+    spec.burstDistribution = random.below(2) == 0 ? WorkloadSpec::Exponential : WorkloadSpec::Pareto;
+    spec.meanBurst = 1 + 10 * random.uniform();
+    spec.priorityLevels = 1 + random.below(10);
+    if (withIo && random.below(3) == 0)
+    {
+        spec.ioDevices = 1 + random.below(3);
+        spec.meanIoBursts = 0.5 + 2 * random.uniform();
+        spec.meanIoTime = 1 + 10 * random.uniform();
+    }
+
+    ProcessTable generated;
+    generateWorkload(spec, generated);
+
+    std::vector<size_t> rows(generated.size());
+    std::iota(rows.begin(), rows.end(), 0);
+    std::vector<int> pids(generated.size());
+    std::iota(pids.begin(), pids.end(), 1 + random.below(1000));
+    for (size_t i = rows.size(); i > 1; --i)
+    {
+        std::swap(rows[i - 1], rows[random.below(static_cast<int>(i))]);
+        std::swap(pids[i - 1], pids[random.below(static_cast<int>(i))]);
+    }
+
+    workload = ProcessTable();
+    for (size_t i = 0; i < rows.size(); ++i)
+    {
+        size_t row = rows[i];
+        workload.add(pids[i], generated.arrivalTime[row], generated.firstBurst(row), generated.priority[row]);
+        for (uint32_t k = 0; generated.hasIo() && k < generated.ioCount[row]; ++k)
+        {
+            IoBurst burst = generated.ioBursts[generated.ioFirst[row] + k];
+            if (random.below(8) == 0)
+                burst.ioTime = 0;
+            workload.addIoBurst(burst.device, burst.ioTime, burst.cpuTime);
+        }
+    }
+
+    options = PolicyOptions();
+    options.quantum = 1 + random.below(8);
+    options.levels = 1 + random.below(4);
+    options.boostInterval = random.below(2) == 0 ? 0 : 5 + random.below(100);
+
+    // Une charge sur quatre commence avant la date 0
+    if (random.below(4) == 0)
+    {
+        int shift = 1 + random.below(1000);
+        for (int &arrival : workload.arrivalTime)
+            arrival -= shift;
+    }
+}
+
+// Premier écart entre la référence et le moteur, vide s'il n'y en a pas
+template <typename Expected, typename Actual>
+static std::string compare(const ProcessTable &expected, const Expected &expectedTimeline,
+                           const ProcessTable &actual, const Actual &actualTimeline)
+{
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        if (expected.pid[i] != actual.pid[i] || expected.waitingTime[i] != actual.waitingTime[i] ||
+            expected.turnaroundTime[i] != actual.turnaroundTime[i] ||
+            expected.responseTime[i] != actual.responseTime[i])
+        {
+            return "processus " + std::to_string(expected.pid[i]) + " : attendu attente " +
+                   std::to_string(expected.waitingTime[i]) + ", rotation " +
+                   std::to_string(expected.turnaroundTime[i]) + ", réponse " +
+                   std::to_string(expected.responseTime[i]) + " ; obtenu pid " + std::to_string(actual.pid[i]) +
+                   ", attente " + std::to_string(actual.waitingTime[i]) + ", rotation " +
+                   std::to_string(actual.turnaroundTime[i]) + ", réponse " +
+                   std::to_string(actual.responseTime[i]);
+        }
+    }
+    auto text = [](const Segment &s)
+    {
+        return std::to_string(s.pid) + " [" + std::to_string(s.start) + ", " + std::to_string(s.end) + ")";
+    };
+    size_t common = std::min(expectedTimeline.size(), actualTimeline.size());
+    for (size_t s = 0; s < common; ++s)
+    {
+        const Segment &e = expectedTimeline[s];
+        const Segment &a = actualTimeline[s];
+        if (e.pid != a.pid || e.start != a.start || e.end != a.end)
+            return "segment " + std::to_string(s) + " : attendu " + text(e) + ", obtenu " + text(a);
+    }
+    if (expectedTimeline.size() != actualTimeline.size())
+    {
+        return "chronologie : attendu " + std::to_string(expectedTimeline.size()) + " segments, obtenu " +
+               std::to_string(actualTimeline.size());
+    }
+    return {};
+}
+
+// Premier écart des compteurs agrégés : changements de contexte et temps de
+// service de chaque périphérique, vide s'il n'y en a pas
+static std::string compareCounters(const ReferenceSimulator &reference, const ProcessTable &workload,
+                                   const Metrics &metrics)
+{
+    if (metrics.contextSwitches != reference.contextSwitches)
+    {
+        return "changements de contexte : attendu " + std::to_string(reference.contextSwitches) + ", obtenu " +
+               std::to_string(metrics.contextSwitches);
+    }
+    std::vector<int64_t> busy(workload.ioDevices, 0);
+    for (const IoBurst &burst : workload.ioBursts)
+        busy[burst.device] += burst.ioTime;
+    for (size_t d = 0; d < busy.size(); ++d)
+    {
+        int64_t actual = d < metrics.deviceBusyTime.size() ? metrics.deviceBusyTime[d] : 0;
+        if (actual != busy[d])
+        {
+            return "périphérique " + std::to_string(d) + " : attendu " + std::to_string(busy[d]) +
+                   " de service, obtenu " + std::to_string(actual);
+        }
+    }
+    return {};
+}
+
+// Recopie les segments de la simulation en ligne dans une chronologie
+class TimelineSink : public ScheduleSink
+{
+private:
+    Timeline &timeline;
+
+public:
+    explicit TimelineSink(Timeline &t) : timeline(t) {}
+
+    void segment(int pid, int start, int end) override
+    {
+        timeline.append(pid, start, end);
+    }
+};
+
+// Simulation en ligne de la charge triée de la référence : les arrivées sont
+// soumises par paquets, en avance sur l'horloge, puis l'horloge avance à une
+// date tirée avant la prochaine arrivée non soumise et les terminaisons sont
+// relevées. À chaque pas, l'horloge doit valoir la date demandée et tous les
+// processus terminés avant elle doivent avoir été rendus. Remplit actual
+// (dans l'ordre de expected), sa chronologie et metrics ; renvoie le premier
+// écart d'horloge ou de terminaisons, vide s'il n'y en a pas
+static std::string runOnline(const std::string &name, const PolicyOptions &options, uint64_t seed,
+                             const ProcessTable &expected, ProcessTable &actual, Timeline &actualTimeline,
+                             Metrics &metrics)
+{
+    WorkloadRandom random(streamSeed(seed, 1));
+    TimelineSink sink(actualTimeline);
+    OnlineScheduler scheduler(makePolicy(name, options), &metrics);
+    scheduler.setSink(&sink);
+
+    int lastEnd = 0;
+    for (size_t i = 0; i < expected.size(); ++i)
+        lastEnd = std::max(lastEnd, expected.arrivalTime[i] + expected.turnaroundTime[i]);
+
+    std::vector<Completion> completions;
+    std::vector<Completion> polled;
+    size_t next = 0;
+    int time = expected.empty() ? 0 : expected.arrivalTime[0]; // l'horloge part de la première arrivée
+    while (next < expected.size())
+    {
+        for (int ahead = 1 + random.below(4); ahead > 0 && next < expected.size(); --ahead, ++next)
+        {
+            if (!scheduler.submit(expected.pid[next], expected.arrivalTime[next], expected.burstTime[next],
+                                  expected.priority[next]))
+                return "soumission refusée : processus " + std::to_string(expected.pid[next]);
+        }
+
+        int limit = next < expected.size() ? expected.arrivalTime[next] : lastEnd + 1;
+        time += random.below(limit - time + 1);
+        scheduler.advanceTo(time);
+        if (scheduler.now() != time)
+            return "horloge : attendu " + std::to_string(time) + ", obtenu " + std::to_string(scheduler.now());
+
+        scheduler.pollCompletions(completions);
+        polled.insert(polled.end(), completions.begin(), completions.end());
+        size_t done = 0;
+        for (size_t i = 0; i < expected.size(); ++i)
+            done += expected.arrivalTime[i] + expected.turnaroundTime[i] < time;
+        if (polled.size() != done)
+        {
+            return "avant " + std::to_string(time) + " : attendu " + std::to_string(done) +
+                   " terminaisons, obtenu " + std::to_string(polled.size());
+        }
+    }
+    scheduler.finish();
+    scheduler.pollCompletions(completions);
+    polled.insert(polled.end(), completions.begin(), completions.end());
+
+    std::unordered_map<int, size_t> rows;
+    for (size_t i = 0; i < expected.size(); ++i)
+        rows[expected.pid[i]] = i;
+    actual = expected;
+    actual.resetResults();
+    for (const Completion &completion : polled)
+    {
+        size_t row = rows.at(completion.pid);
+        actual.waitingTime[row] = completion.waitingTime;
+        actual.turnaroundTime[row] = completion.turnaroundTime;
+        actual.responseTime[row] = completion.responseTime;
+    }
+    return {};
+}
+
+// Politique témoin du vol de travail : chaque fois que pop() laisse la file
+// vide, un processus fantôme y est poussé puis aussitôt volé, comme par un
+// autre processeur, tant que le fantôme n'est pas réellement arrivé. steal()
+// ne devant rien changer pour l'élu, la simulation doit rester la même.
+class StealProbe : public SchedulingPolicy
+{
+private:
+    std::unique_ptr<SchedulingPolicy> policy;
+    const ProcessTable *table = nullptr;
+    size_t ghost;
+    bool &failed; // steal() n'a pas rendu le fantôme
+    int now = 0;
+
+public:
+    StealProbe(std::unique_ptr<SchedulingPolicy> p, size_t g, bool &f) : policy(std::move(p)), ghost(g), failed(f) {}
+
+    void push(size_t index) override
+    {
+        policy->push(index);
+    }
+
+    size_t pop() override
+    {
+        size_t index = policy->pop();
+        if (policy->empty() && now < table->arrivalTime[ghost])
+        {
+            policy->push(ghost);
+            failed = failed || policy->steal() != ghost;
+        }
+        return index;
+    }
+
+    size_t steal() override
+    {
+        return policy->steal();
+    }
+
+    bool empty() const override
+    {
+        return policy->empty();
+    }
+
+    void attach(ProcessTable &t) override
+    {
+        table = &t;
+        policy->attach(t);
+    }
+
+    void update(size_t index) override
+    {
+        policy->update(index);
+    }
+
+    void advance(int currentTime) override
+    {
+        now = currentTime;
+        policy->advance(currentTime);
+    }
+
+    void block(size_t index) override
+    {
+        policy->block(index);
+    }
+
+    bool preempts(size_t arrived, size_t running) const override
+    {
+        return policy->preempts(arrived, running);
+    }
+
+    int timeSlice(int remainingTime) const override
+    {
+        return policy->timeSlice(remainingTime);
+    }
+};
+
+// Cohérence d'une simulation multiprocesseur : rien ne se chevauche sur un
+// processeur, aucun processus ne s'exécute sur deux à la fois, chacun reçoit
+// exactement sa durée et ses résultats découlent de ses segments
+static std::string checkSmp(const ProcessTable &processes, const std::vector<Timeline> &timelines)
+{
+    std::vector<Segment> runs;
+    for (size_t c = 0; c < timelines.size(); ++c)
+    {
+        for (size_t s = 0; s < timelines[c].size(); ++s)
+        {
+            const Segment &segment = timelines[c][s];
+            if (segment.start >= segment.end || (s > 0 && segment.start < timelines[c][s - 1].end))
+                return "processeur " + std::to_string(c) + " : segment " + std::to_string(s) + " mal placé";
+            runs.push_back(segment);
+        }
+    }
+    std::sort(runs.begin(), runs.end(), [](const Segment &a, const Segment &b)
+              { return std::make_pair(a.pid, a.start) < std::make_pair(b.pid, b.start); });
+
+    std::unordered_map<int, size_t> rows;
+    for (size_t i = 0; i < processes.size(); ++i)
+        rows[processes.pid[i]] = i;
+    size_t seen = 0;
+    for (size_t first = 0, last = 0; first < runs.size(); first = last, ++seen)
+    {
+        int pid = runs[first].pid;
+        int total = 0;
+        for (last = first; last < runs.size() && runs[last].pid == pid; ++last)
+        {
+            if (last > first && runs[last].start < runs[last - 1].end)
+                return "processus " + std::to_string(pid) + " sur deux processeurs à " + std::to_string(runs[last].start);
+            total += runs[last].end - runs[last].start;
+        }
+
+        auto row = rows.find(pid);
+        if (row == rows.end())
+            return "processus " + std::to_string(pid) + " inconnu";
+        size_t i = row->second;
+        int turnaround = runs[last - 1].end - processes.arrivalTime[i];
+        if (total != processes.burstTime[i] || processes.responseTime[i] != runs[first].start - processes.arrivalTime[i] ||
+            processes.turnaroundTime[i] != turnaround || processes.waitingTime[i] != turnaround - total)
+        {
+            return "processus " + std::to_string(pid) + " : " + std::to_string(total) + " exécutés sur " +
+                   std::to_string(processes.burstTime[i]) + ", rotation " + std::to_string(processes.turnaroundTime[i]) +
+                   " pour " + std::to_string(turnaround);
+        }
+    }
+    if (seen != processes.size())
+        return std::to_string(processes.size() - seen) + " processus jamais exécutés";
+    return {};
+}
+
+// Essai multiprocesseur : sur un processeur, SmpSimulator doit donner
+// exactement le moteur ; sur plusieurs (2 à 4, tirés de la graine), la
+// simulation doit être cohérente et ne pas changer quand des vols témoins
+// s'ajoutent aux vrais. Un fantôme arrivant après tous les autres sert aux
+// vols témoins. Renvoie le premier écart, vide s'il n'y en a pas
+static std::string runSmp(const std::string &name, const PolicyOptions &options, uint64_t seed,
+                          const ProcessTable &workload, size_t &steals)
+{
+    ProcessTable table = workload;
+    int end = 0, lastPid = 0;
+    for (size_t i = 0; i < workload.size(); ++i)
+    {
+        end = std::max(end, workload.arrivalTime[i]) + workload.burstTime[i];
+        lastPid = std::max(lastPid, workload.pid[i]);
+    }
+    table.add(lastPid + 1, end + 1, 1, 0);
+    size_t ghost = table.size() - 1; // dernier aussi une fois la table triée par arrivée
+    auto makeQueue = [&]()
+    {
+        return makePolicy(name, options);
+    };
+
+    ProcessTable single = table;
+    Timeline singleTimeline;
+    makeVirtualEngine(name, single, options, &singleTimeline)->run();
+    SmpConfig config;
+    config.cpus = 1;
+    ProcessTable one = table;
+    std::vector<Timeline> oneTimelines;
+    SmpSimulator(one, config, makeQueue, &oneTimelines).run();
+    std::string difference = compare(single, singleTimeline, one, oneTimelines[0]);
+    if (!difference.empty())
+        return "1 processeur : " + difference;
+
+    WorkloadRandom random(streamSeed(seed, 2));
+    config.cpus = 2 + random.below(3);
+    std::string cpus = std::to_string(config.cpus) + " processeurs";
+    ProcessTable plain = table;
+    std::vector<Timeline> plainTimelines;
+    SmpSimulator simulator(plain, config, makeQueue, &plainTimelines);
+    simulator.run();
+    for (const CpuStats &stats : simulator.stats())
+        steals += stats.steals;
+    difference = checkSmp(plain, plainTimelines);
+    if (!difference.empty())
+        return cpus + " : " + difference;
+
+    bool failed = false;
+    ProcessTable probed = table;
+    std::vector<Timeline> probedTimelines;
+    SmpSimulator(probed, config, [&]()
+                 { return std::make_unique<StealProbe>(makeQueue(), ghost, failed); }, &probedTimelines)
+        .run();
+    if (failed)
+        return cpus + ", vols témoins : steal() n'a pas rendu le fantôme";
+    for (size_t c = 0; c < plainTimelines.size(); ++c)
+    {
+        difference = compare(plain, plainTimelines[c], probed, probedTimelines[c]);
+        if (!difference.empty())
+            return cpus + ", vols témoins, processeur " + std::to_string(c) + " : " + difference;
+    }
+    return {};
+}
+
+// Traces que les lecteurs doivent refuser. En CSV : rafale de calcul nulle
+// ou négative, en tête ou après une entrée-sortie, et entrée-sortie négative
+// (une entrée-sortie nulle reste permise). En binaire : durée nulle ou
+// négative, que TraceWriter refuse aussi d'écrire. Renvoie le premier cas
+// accepté à tort, vide si tous sont refusés
+static std::string checkTraceRejects(size_t &rejected)
+{
+    const char *invalid[] = {"0,0", "0,-3", "0,0/2/3", "0,4/2/0", "0,4/2@1/-2", "0,4/-1/2", "0,4/-1@1/2"};
+    std::string path = (std::filesystem::temp_directory_path() / "verify-trace").string();
+    auto parses = [&](const std::string &line, std::string &error)
+    {
+        std::ofstream(path) << line << "\n";
+        CsvReader reader(path);
+        TraceRecord record;
+        bool accepted = reader.next(record);
+        error = reader.error();
+        return accepted;
+    };
+
+    std::string error;
+    std::string difference;
+    for (const char *line : invalid)
+    {
+        if (parses(line, error) || error.find("ligne 1 invalide") == std::string::npos)
+        {
+            difference = std::string("ligne acceptée : ") + line;
+            break;
+        }
+        rejected++;
+    }
+    if (difference.empty() && !parses("0,4/0/2,1", error))
+        difference = "ligne refusée : 0,4/0/2,1 (" + error + ")";
+
+    // Le second enregistrement est invalide : écrit à la main, TraceWriter le refusant
+    for (int32_t burst : {0, -3})
+    {
+        if (!difference.empty())
+            break;
+        TraceRecord records[] = {{0, 2, 0}, {1, burst, 0}};
+        {
+            TraceWriter writer(path);
+            if (!writer.write(records[0]) || writer.write(records[1]))
+                difference = "TraceWriter écrit la durée " + std::to_string(burst);
+        }
+        TraceHeader header = {{traceMagic[0], traceMagic[1], traceMagic[2], traceMagic[3]}, traceVersion, 2};
+        std::ofstream out(path, std::ios::binary);
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char *>(records), sizeof(records));
+        out.close();
+
+        MappedTrace trace(path);
+        TraceRecord record;
+        bool first = trace.next(record);
+        if (difference.empty() && (!first || trace.next(record) ||
+                                   trace.error().find("enregistrement 2 : durée invalide") == std::string::npos))
+            difference = "enregistrement binaire accepté : durée " + std::to_string(burst);
+        if (difference.empty())
+            rejected++;
+    }
+    std::filesystem::remove(path);
+    return difference;
+}
+
+// Charge à entrées-sorties dont le résultat est calculé à la main : lignes
+// CSV, puis attente, rotation et réponse de chaque ligne, chronologie et
+// changements de contexte attendus
+struct IoCase
+{
+    const char *policy;
+    int quantum;
+    const char *csv;
+    std::vector<std::array<int, 3>> results;
+    std::vector<Segment> timeline;
+    int64_t contextSwitches;
+};
+
+// La référence puis le moteur (boucles spécialisée et virtuelle) doivent
+// retrouver chaque charge calculée à la main ; renvoie le premier écart
+static std::string checkIoCases(size_t &checked)
+{
+    const IoCase cases[] = {
+        // 1 revient du périphérique 0 quand 2 se termine et passe derrière 3,
+        // arrivé pendant son absence ; les périphériques 0 et 1 servent en parallèle
+        {"fcfs", 1, "0,4/3/2\n1,3\n2,2/5@1/1\n",
+         {{2, 11, 0}, {3, 6, 3}, {5, 13, 5}},
+         {{1, 0, 4}, {2, 4, 7}, {3, 7, 9}, {1, 9, 11}, {3, 14, 15}}, 4},
+        // 2 attend en file que 1 libère le périphérique 0 : son attente en
+        // file compte comme du blocage, pas comme de l'attente
+        {"rr", 2, "0,2/4/1\n0,1/3/1\n",
+         {{0, 7, 0}, {2, 10, 2}},
+         {{1, 0, 2}, {2, 2, 3}, {1, 6, 7}, {2, 9, 10}}, 3},
+    };
+    std::string path = (std::filesystem::temp_directory_path() / "verify-io").string();
+
+    std::string difference;
+    for (const IoCase &c : cases)
+    {
+        std::string label = std::string(c.policy) + " sur " + std::to_string(c.results.size()) + " processus";
+        std::ofstream(path) << c.csv;
+        CsvReader reader(path);
+        ProcessTable workload;
+        if (!loadWorkload(reader, workload))
+        {
+            difference = label + " : charge illisible (" + reader.error() + ")";
+            break;
+        }
+        ProcessTable expected = workload;
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            expected.waitingTime[i] = c.results[i][0];
+            expected.turnaroundTime[i] = c.results[i][1];
+            expected.responseTime[i] = c.results[i][2];
+        }
+
+        PolicyOptions options;
+        options.quantum = c.quantum;
+        ProcessTable simulated = workload;
+        std::vector<Segment> referenceTimeline;
+        ReferenceSimulator reference(c.policy, options);
+        reference.run(simulated, referenceTimeline);
+        difference = compare(expected, c.timeline, simulated, referenceTimeline);
+        if (difference.empty() && reference.contextSwitches != c.contextSwitches)
+        {
+            difference = "changements de contexte : attendu " + std::to_string(c.contextSwitches) + ", obtenu " +
+                         std::to_string(reference.contextSwitches);
+        }
+        if (!difference.empty())
+        {
+            difference = label + ", référence : " + difference;
+            break;
+        }
+
+        for (const std::string dispatch : {"static", "virtual"})
+        {
+            ProcessTable actual = workload;
+            Timeline actualTimeline;
+            Metrics metrics;
+            std::unique_ptr<SimulationEngine> engine =
+                dispatch == "static" ? makeEngine(c.policy, actual, options, &actualTimeline)
+                                     : makeVirtualEngine(c.policy, actual, options, &actualTimeline);
+            engine->setMetrics(&metrics);
+            engine->run();
+            difference = compare(expected, c.timeline, actual, actualTimeline);
+            if (difference.empty())
+                difference = compareCounters(reference, workload, metrics);
+            if (!difference.empty())
+            {
+                difference = label + ", moteur (" + dispatch + ") : " + difference;
+                break;
+            }
+        }
+        if (!difference.empty())
+            break;
+        checked++;
+    }
+    std::filesystem::remove(path);
+    return difference;
+}
+
+static void reportMismatch(const std::string &policy, const std::string &dispatch, uint64_t seed,
+                           const PolicyOptions &options, const ProcessTable &workload, const std::string &difference)
+{
+    std::cerr << "Écart " << policy << " (" << dispatch << "), graine " << seed << ", quantum " << options.quantum
+              << ", niveaux " << options.levels << ", remontée " << options.boostInterval << "\n  "
+              << difference << "\n  charge (pid,arrivée,rafales,priorité) :\n";
+    for (size_t i = 0; i < workload.size(); ++i)
+    {
+        std::cerr << "  " << workload.pid[i] << "," << workload.arrivalTime[i] << "," << workload.firstBurst(i);
+        for (uint32_t k = 0; workload.hasIo() && k < workload.ioCount[i]; ++k)
+        {
+            const IoBurst &burst = workload.ioBursts[workload.ioFirst[i] + k];
+            std::cerr << "/" << burst.ioTime << "@" << burst.device << "/" << burst.cpuTime;
+        }
+        std::cerr << "," << workload.priority[i] << "\n";
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::string policies = "fcfs,rr,sjf,priority,mlfq";
+    size_t trials = 1000;
+    size_t maxProcesses = 200;
+    uint64_t seed = 1;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if ((arg == "-p" || arg == "--policy") && i + 1 < argc)
+            policies = argv[++i];
+        else if ((arg == "-n" || arg == "--trials") && i + 1 < argc)
+            trials = strtoull(argv[++i], nullptr, 10);
+        else if ((arg == "-m" || arg == "--max") && i + 1 < argc)
+            maxProcesses = std::max<size_t>(1, strtoull(argv[++i], nullptr, 10));
+        else if ((arg == "-s" || arg == "--seed") && i + 1 < argc)
+            seed = strtoull(argv[++i], nullptr, 10);
+        else
+        {
+            usage(argv[0]);
+            return arg == "-h" || arg == "--help" ? 0 : 2;
+        }
+    }
+
+    std::vector<std::string> names = splitList(policies);
+    for (const auto &name : names)
+    {
+        if (!ReferenceSimulator::supports(name))
+        {
+            std::cerr << "Pas de modèle de référence pour la politique : " << name << "\n";
+            return 2;
+        }
+    }
+
+    size_t rejected = 0;
+    std::string traceDifference = checkTraceRejects(rejected);
+    if (!traceDifference.empty())
+    {
+        std::cerr << "Écart des lecteurs de traces : " << traceDifference << "\n";
+        return 1;
+    }
+    std::printf("Traces : %zu enregistrements invalides refusés\n", rejected);
+
+    size_t ioCases = 0;
+    std::string ioDifference = checkIoCases(ioCases);
+    if (!ioDifference.empty())
+    {
+        std::cerr << "Écart d'une charge à entrées-sorties : " << ioDifference << "\n";
+        return 1;
+    }
+    std::printf("Entrées-sorties : %zu charges calculées à la main retrouvées\n\n", ioCases);
+
+    std::printf("%-10s %8s %10s %10s %12s %12s %10s\n",
+                "Policy", "Trials", "Processes", "Mismatches", "ref ms", "engine ms", "Speedup");
+
+    bool failed = false;
+    for (const auto &name : names)
+    {
+        using Clock = std::chrono::steady_clock;
+        size_t processCount = 0;
+        size_t mismatches = 0;
+        double referenceTime = 0;
+        double engineTime = 0;
+
+        for (size_t trial = 0; trial < trials; ++trial)
+        {
+            uint64_t trialSeed = seed + trial;
+            ProcessTable workload;
+            PolicyOptions options;
+            drawTrial(trialSeed, maxProcesses, true, workload, options);
+            processCount += workload.size();
+
+            ProcessTable expected = workload;
+            std::vector<Segment> expectedTimeline;
+            ReferenceSimulator reference(name, options);
+            Clock::time_point start = Clock::now();
+            reference.run(expected, expectedTimeline);
+            referenceTime += std::chrono::duration<double>(Clock::now() - start).count();
+
+            for (const std::string dispatch : {"static", "virtual", "online"})
+            {
+                // submit() ne prend pas d'entrées-sorties
+                if (dispatch == "online" && workload.hasIo())
+                    continue;
+
+                ProcessTable actual = workload;
+                Timeline actualTimeline;
+                Metrics metrics;
+                std::string difference;
+                if (dispatch == "online")
+                {
+                    difference = runOnline(name, options, trialSeed, expected, actual, actualTimeline, metrics);
+                }
+                else
+                {
+                    std::unique_ptr<SimulationEngine> engine =
+                        dispatch == "static" ? makeEngine(name, actual, options, &actualTimeline)
+                                             : makeVirtualEngine(name, actual, options, &actualTimeline);
+                    engine->setMetrics(&metrics);
+                    start = Clock::now();
+                    engine->run();
+                    if (dispatch == "static")
+                        engineTime += std::chrono::duration<double>(Clock::now() - start).count();
+                }
+
+                if (difference.empty())
+                    difference = compare(expected, expectedTimeline, actual, actualTimeline);
+                if (difference.empty())
+                    difference = compareCounters(reference, workload, metrics);
+                if (!difference.empty())
+                {
+                    // La charge n'est affichée que pour le premier écart de la politique
+                    if (mismatches == 0)
+                        reportMismatch(name, dispatch, trialSeed, options, workload, difference);
+                    mismatches++;
+                }
+            }
+        }
+
+        std::printf("%-10s %8zu %10zu %10zu %12.2f %12.2f %9.1fx\n",
+                    name.c_str(), trials, processCount, mismatches, referenceTime * 1e3, engineTime * 1e3,
+                    engineTime > 0 ? referenceTime / engineTime : 0.0);
+        std::fflush(stdout);
+        failed = failed || mismatches > 0;
+    }
+
+    std::printf("\n%-10s %8s %10s %10s %10s\n", "SMP", "Trials", "Processes", "Steals", "Mismatches");
+    for (const std::string name : {"mlfq", "cfs"})
+    {
+        size_t processCount = 0;
+        size_t steals = 0;
+        size_t mismatches = 0;
+        for (size_t trial = 0; trial < trials; ++trial)
+        {
+            uint64_t trialSeed = seed + trial;
+            ProcessTable workload;
+            PolicyOptions options;
+            drawTrial(trialSeed, maxProcesses, false, workload, options);
+            processCount += workload.size();
+
+            std::string difference = runSmp(name, options, trialSeed, workload, steals);
+            if (!difference.empty())
+            {
+                if (mismatches == 0)
+                    reportMismatch(name, "smp", trialSeed, options, workload, difference);
+                mismatches++;
+            }
+        }
+        std::printf("%-10s %8zu %10zu %10zu %10zu\n", name.c_str(), trials, processCount, steals, mismatches);
+        std::fflush(stdout);
+        failed = failed || mismatches > 0;
+    }
+    return failed ? 1 : 0;
+}
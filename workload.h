@@ -0,0 +1,292 @@
+#pragma once
+
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "process_table.h"
+
+// Un processus tel qu'il apparaît dans une trace : 12 octets, sans nom
+struct TraceRecord
+{
+    int32_t arrivalTime;
+    int32_t burstTime;
+    int32_t priority;
+};
+
+static_assert(sizeof(TraceRecord) == 12, "TraceRecord doit rester un enregistrement de 12 octets");
+
+// Source de processus lue au fil de l'eau, enregistrement par enregistrement
+class WorkloadSource
+{
+private:
+    std::string message;
+    bool sortedArrivals = false;
+    int32_t lastArrival = INT32_MIN;
+
+protected:
+    std::vector<IoBurst> io; // entrées-sorties du dernier enregistrement renvoyé
+
+    bool fail(const std::string &text)
+    {
+        if (message.empty())
+        {
+            message = text;
+        }
+        return false;
+    }
+
+    // À appeler par next() sur chaque enregistrement avant de le renvoyer :
+    // une durée nulle ou négative ferait reculer le temps de la simulation
+    bool accept(const TraceRecord &record, const char *unit, long position)
+    {
+        if (record.burstTime <= 0)
+            return fail(std::string(unit) + " " + std::to_string(position) + " : durée invalide");
+        if (sortedArrivals && record.arrivalTime < lastArrival)
+        {
+            return fail(std::string(unit) + " " + std::to_string(position) +
+                        " : trace non triée par date d'arrivée");
+        }
+        lastArrival = record.arrivalTime;
+        return true;
+    }
+
+public:
+    virtual ~WorkloadSource() = default;
+
+    // false en fin de trace ou sur erreur (voir error())
+    virtual bool next(TraceRecord &record) = 0;
+
+    // Nombre d'enregistrements attendus, 0 s'il est inconnu
+    virtual size_t sizeHint() const
+    {
+        return 0;
+    }
+
+    // Exige des dates d'arrivée croissantes, nécessaire pour simuler sans tout charger
+    void requireSortedArrivals()
+    {
+        sortedArrivals = true;
+    }
+
+    const std::string &error() const
+    {
+        return message;
+    }
+
+    // Entrées-sorties du processus renvoyé par le dernier next(), chacune
+    // suivie d'une rafale de calcul ; record.burstTime est alors la première
+    // rafale. Toujours vide pour une trace binaire.
+    const std::vector<IoBurst> &ioBursts() const
+    {
+        return io;
+    }
+};
+
+// Lecteur CSV par blocs : une ligne "arrivée,durée[,priorité]" par processus,
+// lignes vides et commentaires '#' ignorés. Aucune allocation par ligne.
+// La durée peut être une séquence de rafales "calcul/e-s/calcul/...", où
+// chaque entrée-sortie porte au besoin son périphérique : "4/3@1/2" calcule
+// 4, attend 3 sur le périphérique 1, puis calcule 2 (périphérique 0 par défaut).
+class CsvReader : public WorkloadSource
+{
+private:
+    std::FILE *file = nullptr;
+    bool owned = false;
+    std::vector<char> buffer;
+    size_t begin = 0;
+    size_t end = 0;
+    bool eof = false;
+    long lineNumber = 0;
+
+    // Décale la fin de ligne entamée en tête du tampon et le complète
+    bool refill()
+    {
+        if (begin > 0)
+        {
+            std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+            end -= begin;
+            begin = 0;
+        }
+        if (end == buffer.size())
+        {
+            return fail("ligne " + std::to_string(lineNumber + 1) + " trop longue");
+        }
+
+        size_t count = std::fread(buffer.data() + end, 1, buffer.size() - end, file);
+        end += count;
+        if (count == 0)
+        {
+            if (std::ferror(file))
+            {
+                return fail("erreur de lecture");
+            }
+            eof = true;
+        }
+        return true;
+    }
+
+    static const char *skipBlanks(const char *p, const char *last)
+    {
+        while (p < last && (*p == ' ' || *p == '\t' || *p == '\r'))
+            p++;
+        return p;
+    }
+
+    static bool parseNumber(const char *&p, const char *last, int32_t &value)
+    {
+        p = skipBlanks(p, last);
+        auto result = std::from_chars(p, last, value);
+        if (result.ec != std::errc())
+            return false;
+        p = skipBlanks(result.ptr, last);
+        return true;
+    }
+
+    // Passe la virgule qui suit un champ, ou vérifie la fin de ligne
+    static bool endField(const char *&p, const char *last)
+    {
+        if (p < last && *p == ',')
+            p++;
+        else if (p != last)
+            return false;
+        return true;
+    }
+
+    static bool parseField(const char *&p, const char *last, int32_t &value)
+    {
+        return parseNumber(p, last, value) && endField(p, last);
+    }
+
+    // Durée ou séquence de rafales : la première rafale dans first, les
+    // entrées-sorties suivantes dans io. Les rafales de calcul doivent être
+    // positives, les entrées-sorties au moins nulles
+    bool parseBursts(const char *&p, const char *last, int32_t &first)
+    {
+        io.clear();
+        if (!parseNumber(p, last, first) || first <= 0)
+            return false;
+        while (p < last && *p == '/')
+        {
+            IoBurst burst = {0, 0, 0};
+            p++;
+            if (!parseNumber(p, last, burst.ioTime) || burst.ioTime < 0)
+                return false;
+            if (p < last && *p == '@')
+            {
+                p++;
+                if (!parseNumber(p, last, burst.device) || burst.device < 0)
+                    return false;
+            }
+            if (p == last || *p != '/')
+                return false;
+            p++;
+            if (!parseNumber(p, last, burst.cpuTime) || burst.cpuTime <= 0)
+                return false;
+            io.push_back(burst);
+        }
+        return endField(p, last);
+    }
+
+public:
+    // "-" lit l'entrée standard
+    explicit CsvReader(const std::string &path, size_t chunkSize = 1 << 20)
+        : buffer(chunkSize)
+    {
+        if (path == "-")
+        {
+            file = stdin;
+        }
+        else
+        {
+            file = std::fopen(path.c_str(), "rb");
+            owned = file != nullptr;
+            if (file == nullptr)
+            {
+                fail("impossible d'ouvrir " + path);
+            }
+        }
+    }
+
+    ~CsvReader() override
+    {
+        if (owned)
+        {
+            std::fclose(file);
+        }
+    }
+
+    CsvReader(const CsvReader &) = delete;
+    CsvReader &operator=(const CsvReader &) = delete;
+
+    bool isOpen() const
+    {
+        return file != nullptr;
+    }
+
+    bool next(TraceRecord &record) override
+    {
+        if (file == nullptr || !error().empty())
+            return false;
+
+        while (true)
+        {
+            const char *line = buffer.data() + begin;
+            const char *newline = static_cast<const char *>(std::memchr(line, '\n', end - begin));
+            const char *last = newline;
+            if (newline == nullptr)
+            {
+                if (!eof)
+                {
+                    if (!refill())
+                        return false;
+                    continue;
+                }
+                if (begin == end)
+                    return false;
+                last = buffer.data() + end; // dernière ligne sans saut de ligne
+            }
+            begin = (last - buffer.data()) + (newline != nullptr ? 1 : 0);
+            lineNumber++;
+
+            const char *p = skipBlanks(line, last);
+            if (p == last || *p == '#')
+                continue;
+
+            record.priority = 0;
+            bool valid = parseField(p, last, record.arrivalTime) &&
+                         parseBursts(p, last, record.burstTime) &&
+                         (p == last || parseField(p, last, record.priority));
+            if (!valid)
+            {
+                return fail("ligne " + std::to_string(lineNumber) + " invalide : " +
+                            std::string(line, last));
+            }
+            return accept(record, "ligne", lineNumber);
+        }
+    }
+};
+
+// Ajoute un processus lu dans une trace, avec ses entrées-sorties ; les pid
+// suivent le dernier de la table
+inline void appendProcess(ProcessTable &processes, const TraceRecord &record, const std::vector<IoBurst> &io = {})
+{
+    processes.add(processes.lastPid() + 1, record.arrivalTime, record.burstTime, record.priority);
+    for (const IoBurst &burst : io)
+        processes.addIoBurst(burst.device, burst.ioTime, burst.cpuTime);
+}
+
+// Charge toute la source en mémoire ; renvoie false si elle s'est arrêtée sur une erreur
+inline bool loadWorkload(WorkloadSource &source, ProcessTable &processes)
+{
+    processes.reserve(processes.size() + source.sizeHint());
+    TraceRecord record;
+    while (source.next(record))
+    {
+        appendProcess(processes, record, source.ioBursts());
+    }
+    return source.error().empty();
+}